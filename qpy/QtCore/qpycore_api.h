@@ -33,7 +33,11 @@
 
 QT_BEGIN_NAMESPACE
 class QAbstractEventDispatcher;
+class QCborStreamReader;
+class QCborStreamWriter;
+class QDataStream;
 class QObject;
+class QThreadPool;
 QT_END_NAMESPACE
 
 
@@ -99,12 +103,43 @@ int qpycore_canConvertTo_QJsonValue(PyObject *py);
 int qpycore_convertTo_QJsonValue(PyObject *py, PyObject *transferObj,
         QJsonValue **cpp, int *isErr);
 
+// Support for converting between native Python objects and JSON and CBOR.
+PyObject *qpycore_PyObject_FromQJsonValue(const QJsonValue &value);
+bool qpycore_PyObject_AsQJsonValue(PyObject *obj, QJsonValue &value);
+PyObject *qpycore_read_cbor(QCborStreamReader &reader);
+bool qpycore_write_cbor(QCborStreamWriter &writer, PyObject *obj);
+
+// Support for reading QDataStream data into Python buffers.
+qint64 qpycore_qdatastream_read_bytes_into(QDataStream *ds, PyObject *buffer);
+qint64 qpycore_qdatastream_read_array(QDataStream *ds, PyObject *buffer);
+
+// Support for submitting batches of Python callables to a QThreadPool.
+PyObject *qpycore_qthreadpool_submit_many(QThreadPool *pool,
+        PyObject *callables, int batch_size, int priority);
+PyObject *qpycore_qthreadpool_batch_statistics(QThreadPool *pool);
+
 // Support for an embedded qt.conf.
 bool qpycore_qt_conf();
 
 // Utilities.
 void qpycore_Unicode_ConcatAndDel(PyObject **string, PyObject *newpart);
 
+// Versions of SIP_BLOCK_THREADS and SIP_UNBLOCK_THREADS that trace the
+// acquisition of the GIL at a named site.
+#define QPYCORE_BLOCK_THREADS(name) \
+    { \
+        static void *qpycoreGILSite = pyqt6_gil_trace_site(name); \
+        qint64 qpycoreGILBegin = pyqt6_gil_trace_begin(); \
+        SIP_BLOCK_THREADS \
+        qint64 qpycoreGILAcquired = (qpycoreGILBegin ? pyqt6_gil_trace_now() : 0);
+
+#define QPYCORE_UNBLOCK_THREADS \
+        if (qpycoreGILBegin) \
+            pyqt6_gil_trace_end(qpycoreGILSite, qpycoreGILBegin, \
+                    qpycoreGILAcquired); \
+        SIP_UNBLOCK_THREADS \
+    }
+
 // Initialisation.
 void qpycore_init();
 void qpycore_post_init(PyObject *module_dict);
@@ -0,0 +1,57 @@
+// This defines the monotonic clock and time histograms used by the profilers.
+// 
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_CLOCK_H
+#define _QPYCORE_CLOCK_H
+
+
+#include <chrono>
+
+#include <QtAlgorithms>
+#include <QtGlobal>
+
+
+// The number of buckets in a histogram of times.  Bucket i counts times of at
+// least 2**i and less than 2**(i+1) nanoseconds.
+#define QPYCORE_NR_BUCKETS  40
+
+
+// Return the current time of a monotonic clock in nanoseconds.
+inline qint64 qpycore_now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+// Return the histogram bucket of a time in nanoseconds.
+inline int qpycore_bucket(qint64 ns)
+{
+    if (ns <= 1)
+        return 0;
+
+    int b = 63 - qCountLeadingZeroBits(quint64(ns));
+
+    return (b < QPYCORE_NR_BUCKETS ? b : QPYCORE_NR_BUCKETS - 1);
+}
+
+
+#endif
@@ -41,6 +41,8 @@ static bool add_key_value(EnumFlag &enum_flag, bool &unsigned_enum,
 static bool objectify(const char *s, PyObject **objp);
 static bool parse_members(PyObject *members, EnumFlag &enum_flag,
         bool &unsigned_enum);
+static int parse_member_map(PyObject *enum_cls, EnumFlag &enum_flag,
+        bool &unsigned_enum);
 
 
 // The enums keyed by the enum type object.
@@ -98,24 +100,32 @@ static PyObject *decorator(PyObject *, PyObject *enum_cls)
     if (enum_flag.name.isNull())
         return 0;
 
-    // Get the members.
-    static PyObject *members_s = 0;
+    // Get the members, using the fast path if possible.
+    bool unsigned_enum = true;
 
-    if (!objectify("__members__", &members_s))
-        return 0;
+    int rc = parse_member_map(enum_cls, enum_flag, unsigned_enum);
 
-    PyObject *members = PyObject_GetAttr(enum_cls, members_s);
-    if (!members)
+    if (rc < 0)
         return 0;
 
-    bool ok, unsigned_enum = true;
+    if (rc == 0)
+    {
+        static PyObject *members_s = 0;
+
+        if (!objectify("__members__", &members_s))
+            return 0;
 
-    ok = parse_members(members, enum_flag, unsigned_enum);
+        PyObject *members = PyObject_GetAttr(enum_cls, members_s);
+        if (!members)
+            return 0;
 
-    Py_DECREF(members);
+        bool ok = parse_members(members, enum_flag, unsigned_enum);
 
-    if (!ok)
-        return 0;
+        Py_DECREF(members);
+
+        if (!ok)
+            return 0;
+    }
 
     // Get the pseudo fully qualified C++ name.
     static PyObject *qualname_s = 0;
@@ -227,6 +237,75 @@ return_error:
 }
 
 
+// Parse the _member_map_ dict of an enum (which __members__ is a proxy for)
+// reading each value from the member's _value_ attribute rather than the
+// (much slower) value property.  Return 1 if the members were parsed, 0 if the
+// enum doesn't have the expected implementation details or -1 if there was an
+// error.
+static int parse_member_map(PyObject *enum_cls, EnumFlag &enum_flag,
+        bool &unsigned_enum)
+{
+    static PyObject *member_map_s = 0;
+    static PyObject *value_s = 0;
+
+    if (!objectify("_member_map_", &member_map_s))
+        return -1;
+
+    if (!objectify("_value_", &value_s))
+        return -1;
+
+    PyObject *member_map = PyObject_GetAttr(enum_cls, member_map_s);
+
+    if (!member_map)
+    {
+        PyErr_Clear();
+        return 0;
+    }
+
+    if (!PyDict_Check(member_map))
+    {
+        Py_DECREF(member_map);
+        return 0;
+    }
+
+    enum_flag.keys.reserve(PyDict_Size(member_map));
+
+    Py_ssize_t pos = 0;
+    PyObject *key, *member;
+
+    while (PyDict_Next(member_map, &pos, &key, &member))
+    {
+        PyObject *value = PyObject_GetAttr(member, value_s);
+
+        if (!value)
+        {
+            // Fall back to the slow path.
+            PyErr_Clear();
+            Py_DECREF(member_map);
+
+            enum_flag.keys.clear();
+            unsigned_enum = true;
+
+            return 0;
+        }
+
+        bool ok = add_key_value(enum_flag, unsigned_enum, key, value);
+
+        Py_DECREF(value);
+
+        if (!ok)
+        {
+            Py_DECREF(member_map);
+            return -1;
+        }
+    }
+
+    Py_DECREF(member_map);
+
+    return 1;
+}
+
+
 // Add a key/value to an enum/flag.
 static bool add_key_value(EnumFlag &enum_flag, bool &unsigned_enum,
         PyObject *key, PyObject *value)
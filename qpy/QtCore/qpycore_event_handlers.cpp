@@ -69,9 +69,6 @@ static void collecting_wrapper_eh(sipSimpleWrapper *self)
 // Monitor a C++ created QObject instance.
 void PyQtMonitor::monitor(QObject *cppInst)
 {
-    // Connect the monitor.
-    monitored.insert(cppInst);
-
     // Note that the C++ instance may be in the process of being destroyed.
     // This will happen if it is the argument to the destroyed() signal.
     // Python will have forgotten about the object (even if it was created by
@@ -80,9 +77,15 @@ void PyQtMonitor::monitor(QObject *cppInst)
     // to monitoring.  Note that subsequently calling disconnect() would cause
     // a crash - this is why we keep a separate record of C++ instances
     // currently being monitored and never explicitly disconnect the monitor.
+    // The connection is made even if the instance is already recorded because
+    // an instance that is wrapped while being destroyed, or whose destroyed()
+    // signal has yet to be delivered from another thread, leaves a stale
+    // record that a new instance at the same address would match.
+    monitored.insert(cppInst);
+
     Py_BEGIN_ALLOW_THREADS
-    connect(cppInst, SIGNAL(destroyed(QObject *)),
-            SLOT(on_destroyed(QObject *)), Qt::UniqueConnection);
+    connect(cppInst, &QObject::destroyed, this, &PyQtMonitor::on_destroyed,
+            Qt::UniqueConnection);
     Py_END_ALLOW_THREADS
 }
 
@@ -110,14 +113,14 @@ void PyQtMonitor::on_destroyed(QObject *cppInst)
 
         if (sipGetInterpreter())
         {
-            SIP_BLOCK_THREADS
+            QPYCORE_BLOCK_THREADS("PyQtMonitor::on_destroyed()")
 
             PyObject *pyObj = sipGetPyObject(cppInst, sipType_QObject);
 
             if (pyObj)
                 sipInstanceDestroyed((sipSimpleWrapper *)pyObj);
 
-            SIP_UNBLOCK_THREADS
+            QPYCORE_UNBLOCK_THREADS
         }
     }
 }
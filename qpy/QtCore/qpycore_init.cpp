@@ -89,6 +89,11 @@ void qpycore_init()
     sipExportSymbol("pyqt6_get_qmetaobject", (void *)pyqt6_get_qmetaobject);
     sipExportSymbol("pyqt6_get_signal_signature",
             (void *)pyqt6_get_signal_signature);
+    sipExportSymbol("pyqt6_gil_trace_begin", (void *)pyqt6_gil_trace_begin);
+    sipExportSymbol("pyqt6_gil_trace_end", (void *)pyqt6_gil_trace_end);
+    sipExportSymbol("pyqt6_gil_trace_now", (void *)pyqt6_gil_trace_now);
+    sipExportSymbol("pyqt6_gil_trace_site", (void *)pyqt6_gil_trace_site);
+    sipExportSymbol("pyqt6_new_array", (void *)pyqt6_new_array);
     sipExportSymbol("pyqt6_register_from_qvariant_convertor",
             (void *)pyqt6_register_from_qvariant_convertor);
     sipExportSymbol("pyqt6_register_to_qvariant_convertor",
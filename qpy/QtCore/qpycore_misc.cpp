@@ -70,3 +70,41 @@ void qpycore_Unicode_ConcatAndDel(PyObject **string, PyObject *newpart)
 
     Py_XDECREF(newpart);
 }
+
+
+// Release the cached str objects.
+PyQtStringCache::~PyQtStringCache()
+{
+    QHash<QString, PyObject *>::const_iterator it = cache.constBegin();
+
+    while (it != cache.constEnd())
+    {
+        Py_DECREF(it.value());
+        ++it;
+    }
+}
+
+
+// Return a new reference to the str object for a QString.
+PyObject *PyQtStringCache::get(const QString &qstr)
+{
+    QHash<QString, PyObject *>::const_iterator it = cache.constFind(qstr);
+
+    if (it != cache.constEnd())
+    {
+        Py_INCREF(it.value());
+        return it.value();
+    }
+
+    PyObject *str_obj = qpycore_PyObject_FromQString(qstr);
+
+    if (!str_obj)
+        return 0;
+
+    PyUnicode_InternInPlace(&str_obj);
+
+    Py_INCREF(str_obj);
+    cache.insert(qstr, str_obj);
+
+    return str_obj;
+}
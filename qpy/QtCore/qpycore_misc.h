@@ -25,10 +25,31 @@
 #include <Python.h>
 
 #include <QByteArray>
+#include <QHash>
+#include <QString>
 
 #include "sipAPIQtCore.h"
 
 
+// A cache of interned str objects created from QStrings.  It is used when
+// converting large documents so that repeated dict keys share a single
+// object.
+class PyQtStringCache
+{
+public:
+    PyQtStringCache() {}
+    ~PyQtStringCache();
+
+    // Return a new reference to the str object for a QString.
+    PyObject *get(const QString &qstr);
+
+private:
+    QHash<QString, PyObject *> cache;
+
+    PyQtStringCache(const PyQtStringCache &);
+};
+
+
 QByteArray qpycore_convert_ASCII(PyObject *str_obj);
 bool qpycore_is_pyqt_type(const sipTypeDef *td);
 
@@ -399,6 +399,39 @@ sipErrorState pyqt6_get_signal_signature(PyObject *signal,
 }
 
 
+// Create a memoryview of a given format containing a copy of some data or
+// uninitialised data.
+PyObject *pyqt6_new_array(char format, const void *data, Py_ssize_t size,
+        void **data_p)
+{
+    PyObject *bytes = PyByteArray_FromStringAndSize(
+            reinterpret_cast<const char *>(data), size);
+
+    if (!bytes)
+        return 0;
+
+    PyObject *array = PyMemoryView_FromObject(bytes);
+
+    if (array && format != 'B')
+    {
+        char cast_format[2] = {format, '\0'};
+        PyObject *view = array;
+
+        array = PyObject_CallMethod(view, "cast", "s", cast_format);
+
+        Py_DECREF(view);
+    }
+
+    // Note that the memoryview keeps the data alive.
+    if (array && data_p)
+        *data_p = PyByteArray_AsString(bytes);
+
+    Py_DECREF(bytes);
+
+    return array;
+}
+
+
 // Register a convertor function that converts a QVariant to a Python object.
 void pyqt6_register_from_qvariant_convertor(
         bool (*convertor)(const QVariant &, PyObject **))
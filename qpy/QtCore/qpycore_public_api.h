@@ -85,6 +85,24 @@ sipErrorState pyqt6_get_pyqtslot_parts(PyObject *slot, QObject **receiver,
 sipErrorState pyqt6_get_signal_signature(PyObject *signal,
         const QObject *transmitter, QByteArray &signal_signature);
 
+// Support for tracing the acquisition of the GIL by C++ code called from Qt.
+// pyqt6_gil_trace_begin() is called before acquiring the GIL and returns 0 if
+// tracing is disabled.  Otherwise pyqt6_gil_trace_now() is called after
+// acquiring the GIL and pyqt6_gil_trace_end() before releasing it.  A site is
+// identified by a handle returned by pyqt6_gil_trace_site() that should be
+// saved in a function-local static.
+qint64 pyqt6_gil_trace_begin();
+qint64 pyqt6_gil_trace_now();
+void *pyqt6_gil_trace_site(const char *name);
+void pyqt6_gil_trace_end(void *site, qint64 begin, qint64 acquired);
+
+// Create a memoryview of a given format, a single struct module character, of
+// a number of bytes.  If data is not 0 then it is copied into the memoryview.
+// If data_p is not 0 then it is set to the memoryview's data so that it can be
+// filled in.  Returns 0 with a Python exception raised if there was an error.
+PyObject *pyqt6_new_array(char format, const void *data, Py_ssize_t size,
+        void **data_p);
+
 // Register a convertor function that converts a QVariant to a Python object.
 // The convertor will return true if the QVariant was handled, so that no other
 // convertor need be tried.  If the Python object returned was 0 then there was
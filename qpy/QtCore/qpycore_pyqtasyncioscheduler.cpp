@@ -0,0 +1,637 @@
+// This is the implementation of the PyQtAsyncioScheduler class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <Python.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QMetaObject>
+#include <QMutexLocker>
+
+#include "qpycore_clock.h"
+#include "qpycore_public_api.h"
+#include "qpycore_pyqtasyncioscheduler.h"
+
+#include "sipAPIQtCore.h"
+
+
+// The ordering of timers in the heap so that the earliest is at the front.
+// Timers that are due at the same time are run in the order they were added.
+struct TimerLater
+{
+    template<typename T>
+    bool operator()(const T &a, const T &b) const
+    {
+        return (a.when > b.when || (a.when == b.when && a.id > b.id));
+    }
+};
+
+
+// The heap is only purged of cancelled timers when it has at least this many
+// and they make up more than half of it.  This is the same policy as asyncio.
+static const size_t MinCancelledTimers = 100;
+
+
+// Create the scheduler.
+PyQtAsyncioScheduler::PyQtAsyncioScheduler(QObject *parent) : QObject(parent),
+        _cancelled_timers(0), _next_id(0), _iterations(0),
+        _exception_handler(0)
+{
+    _wakeup.setSingleShot(true);
+    _wakeup.setTimerType(Qt::PreciseTimer);
+    connect(&_wakeup, &QTimer::timeout, this, &PyQtAsyncioScheduler::run);
+}
+
+
+// Destroy the scheduler.
+PyQtAsyncioScheduler::~PyQtAsyncioScheduler()
+{
+    // The notifiers are children and will be destroyed automatically.
+    if (!sipGetInterpreter())
+        return;
+
+    QPYCORE_BLOCK_THREADS("PyQtAsyncioScheduler::~PyQtAsyncioScheduler()")
+
+    for (Callback *cb : _ready)
+        release(cb);
+
+    for (const Timer &timer : _timers)
+        release(timer.callback);
+
+    for (Callback *cb : _handles)
+        release(cb);
+
+    for (const Watcher &watcher : _readers)
+        release(watcher.callback);
+
+    for (const Watcher &watcher : _writers)
+        release(watcher.callback);
+
+    for (Callback *cb : _incoming)
+        release(cb);
+
+    Py_XDECREF(_exception_handler);
+
+    QPYCORE_UNBLOCK_THREADS
+}
+
+
+// Return the current time of the scheduler's monotonic clock in seconds.
+double PyQtAsyncioScheduler::time()
+{
+    return qpycore_now() / 1e9;
+}
+
+
+// Schedule a callback to be called during the next iteration.  The GIL must be
+// held.
+quint64 PyQtAsyncioScheduler::callSoon(PyObject *callback, PyObject *args,
+        PyObject *context)
+{
+    Callback *cb = newCallback(callback, args, context);
+
+    if (!cb)
+        return 0;
+
+    // One reference for the handle and one for the queue.
+    cb->refs = 2;
+    _handles.insert(cb->id, cb);
+    _ready.append(cb);
+
+    wakeUp();
+
+    return cb->id;
+}
+
+
+// Schedule a callback from any thread to be called during the next iteration.
+// The GIL must be held.
+quint64 PyQtAsyncioScheduler::callSoonThreadsafe(PyObject *callback,
+        PyObject *args, PyObject *context)
+{
+    Callback *cb = newCallback(callback, args, context);
+
+    if (!cb)
+        return 0;
+
+    // The handle cannot be cancelled so the queue holds the only reference.
+    cb->refs = 1;
+
+    bool first;
+
+    _incoming_mutex.lock();
+    first = _incoming.isEmpty();
+    _incoming.append(cb);
+    _incoming_mutex.unlock();
+
+    // Only the first callback of an iteration needs to wake the scheduler.
+    if (first)
+        QMetaObject::invokeMethod(this, [this]() {
+            wakeUp();
+        }, Qt::QueuedConnection);
+
+    return cb->id;
+}
+
+
+// Schedule a callback to be called at a time of the scheduler's clock.  The GIL
+// must be held.
+quint64 PyQtAsyncioScheduler::callAt(double when, PyObject *callback,
+        PyObject *args, PyObject *context)
+{
+    // A NaN would break the ordering of the heap.
+    if (std::isnan(when))
+    {
+        PyErr_SetString(PyExc_ValueError, "the time cannot be NaN");
+        return 0;
+    }
+
+    Callback *cb = newCallback(callback, args, context);
+
+    if (!cb)
+        return 0;
+
+    // One reference for the handle and one for the heap.
+    cb->refs = 2;
+    cb->in_heap = true;
+    _handles.insert(cb->id, cb);
+
+    qint64 when_ns;
+
+    if (when * 1e9 >= double(std::numeric_limits<qint64>::max()))
+        when_ns = std::numeric_limits<qint64>::max();
+    else if (when * 1e9 <= double(std::numeric_limits<qint64>::min()))
+        when_ns = std::numeric_limits<qint64>::min();
+    else
+        when_ns = qint64(when * 1e9);
+
+    Timer timer = {when_ns, cb->id, cb};
+
+    _timers.push_back(timer);
+    std::push_heap(_timers.begin(), _timers.end(), TimerLater());
+
+    // The wake up time only needs changing if this is now the first timer.
+    if (_ready.isEmpty() && _timers.front().id == cb->id)
+        reschedule();
+
+    return cb->id;
+}
+
+
+// Cancel a callback scheduled with callSoon() or callAt().  Return true if it
+// was still pending.  The GIL must be held.
+bool PyQtAsyncioScheduler::cancel(quint64 handle)
+{
+    Callback *cb = _handles.take(handle);
+
+    if (!cb)
+        return false;
+
+    // Any queue or heap entry is discarded when it is reached but the Python
+    // objects are released now.
+    cb->cancelled = true;
+    Py_CLEAR(cb->callable);
+    Py_CLEAR(cb->args);
+
+    if (cb->in_heap)
+        ++_cancelled_timers;
+
+    release(cb);
+
+    if (_cancelled_timers > MinCancelledTimers &&
+            _cancelled_timers > _timers.size() / 2)
+        purgeCancelledTimers();
+
+    return true;
+}
+
+
+// Call a callback whenever a file descriptor is readable.  Any existing
+// callback is replaced.  The GIL must be held.
+bool PyQtAsyncioScheduler::addReader(qintptr fd, PyObject *callback,
+        PyObject *args, PyObject *context)
+{
+    return addWatcher(_readers, fd, QSocketNotifier::Read, callback, args,
+            context);
+}
+
+
+// Stop watching a file descriptor for reading.  Return true if it was being
+// watched.  The GIL must be held.
+bool PyQtAsyncioScheduler::removeReader(qintptr fd)
+{
+    return removeWatcher(_readers, fd);
+}
+
+
+// Call a callback whenever a file descriptor is writable.  Any existing
+// callback is replaced.  The GIL must be held.
+bool PyQtAsyncioScheduler::addWriter(qintptr fd, PyObject *callback,
+        PyObject *args, PyObject *context)
+{
+    return addWatcher(_writers, fd, QSocketNotifier::Write, callback, args,
+            context);
+}
+
+
+// Stop watching a file descriptor for writing.  Return true if it was being
+// watched.  The GIL must be held.
+bool PyQtAsyncioScheduler::removeWriter(qintptr fd)
+{
+    return removeWatcher(_writers, fd);
+}
+
+
+// Set the callable that is passed any exception raised by a callback.  If it
+// is None then the exception is handled as one raised by a slot.  The GIL must
+// be held.
+void PyQtAsyncioScheduler::setExceptionHandler(PyObject *handler)
+{
+    if (handler == Py_None)
+        handler = 0;
+
+    Py_XINCREF(handler);
+    Py_XDECREF(_exception_handler);
+    _exception_handler = handler;
+}
+
+
+// Create a callback.  If there is a context then the callback is invoked using
+// its run() method.  The GIL must be held.
+PyQtAsyncioScheduler::Callback *PyQtAsyncioScheduler::newCallback(
+        PyObject *callback, PyObject *args, PyObject *context)
+{
+    if (args == Py_None)
+        args = 0;
+
+    if (args && !PyTuple_Check(args))
+    {
+        PyErr_Format(PyExc_TypeError, "args must be a tuple, not '%s'",
+                sipPyTypeName(Py_TYPE(args)));
+        return 0;
+    }
+
+    PyObject *callable, *call_args;
+
+    if (context && context != Py_None)
+    {
+        callable = PyObject_GetAttrString(context, "run");
+
+        if (!callable)
+            return 0;
+
+        Py_ssize_t nr_args = (args ? PyTuple_Size(args) : 0);
+
+        call_args = PyTuple_New(nr_args + 1);
+
+        if (!call_args)
+        {
+            Py_DECREF(callable);
+            return 0;
+        }
+
+        Py_INCREF(callback);
+        PyTuple_SetItem(call_args, 0, callback);
+
+        for (Py_ssize_t i = 0; i < nr_args; ++i)
+        {
+            PyObject *arg = PyTuple_GetItem(args, i);
+
+            Py_INCREF(arg);
+            PyTuple_SetItem(call_args, i + 1, arg);
+        }
+    }
+    else
+    {
+        callable = callback;
+        Py_INCREF(callable);
+
+        if (args)
+        {
+            call_args = args;
+            Py_INCREF(call_args);
+        }
+        else
+        {
+            call_args = PyTuple_New(0);
+
+            if (!call_args)
+            {
+                Py_DECREF(callable);
+                return 0;
+            }
+        }
+    }
+
+    Callback *cb = new Callback;
+
+    cb->id = ++_next_id;
+    cb->callable = callable;
+    cb->args = call_args;
+    cb->refs = 0;
+    cb->cancelled = false;
+    cb->queued = false;
+    cb->in_heap = false;
+
+    return cb;
+}
+
+
+// Release a reference to a callback.  The GIL must be held unless the
+// callback has been cancelled.
+void PyQtAsyncioScheduler::release(Callback *cb)
+{
+    if (--cb->refs > 0)
+        return;
+
+    Py_XDECREF(cb->callable);
+    Py_XDECREF(cb->args);
+    delete cb;
+}
+
+
+// Remove all the cancelled timers from the heap.  The GIL must be held.
+void PyQtAsyncioScheduler::purgeCancelledTimers()
+{
+    std::vector<Timer>::iterator first_cancelled = std::partition(
+            _timers.begin(), _timers.end(), [](const Timer &timer) {
+                return !timer.callback->cancelled;
+            });
+
+    for (std::vector<Timer>::iterator it = first_cancelled;
+            it != _timers.end(); ++it)
+        release(it->callback);
+
+    _timers.erase(first_cancelled, _timers.end());
+    std::make_heap(_timers.begin(), _timers.end(), TimerLater());
+
+    _cancelled_timers = 0;
+
+    reschedule();
+}
+
+
+// Watch a file descriptor.  The GIL must be held.
+bool PyQtAsyncioScheduler::addWatcher(QHash<qintptr, Watcher> &watchers,
+        qintptr fd, QSocketNotifier::Type type, PyObject *callback,
+        PyObject *args, PyObject *context)
+{
+    Callback *cb = newCallback(callback, args, context);
+
+    if (!cb)
+        return false;
+
+    cb->refs = 1;
+
+    QHash<qintptr, Watcher>::iterator it = watchers.find(fd);
+
+    if (it != watchers.end())
+    {
+        // Replace the callback but keep the notifier.
+        it->callback->cancelled = true;
+        release(it->callback);
+        it->callback = cb;
+    }
+    else
+    {
+        Watcher watcher;
+
+        watcher.notifier = new QSocketNotifier(fd, type, this);
+        watcher.callback = cb;
+
+        QHash<qintptr, Watcher> *watchers_p = &watchers;
+
+        connect(watcher.notifier, &QSocketNotifier::activated, this,
+                [this, watchers_p, fd]() {
+                    activated(watchers_p, fd);
+                });
+
+        watchers.insert(fd, watcher);
+    }
+
+    return true;
+}
+
+
+// Stop watching a file descriptor.  The GIL must be held.
+bool PyQtAsyncioScheduler::removeWatcher(QHash<qintptr, Watcher> &watchers,
+        qintptr fd)
+{
+    QHash<qintptr, Watcher>::iterator it = watchers.find(fd);
+
+    if (it == watchers.end())
+        return false;
+
+    it->callback->cancelled = true;
+    release(it->callback);
+    delete it->notifier;
+
+    watchers.erase(it);
+
+    return true;
+}
+
+
+// Handle the activation of a file descriptor notifier.  This only queues the
+// callback so the GIL isn't needed.  Further activations are ignored until the
+// callback has been run.
+void PyQtAsyncioScheduler::activated(QHash<qintptr, Watcher> *watchers,
+        qintptr fd)
+{
+    QHash<qintptr, Watcher>::iterator it = watchers->find(fd);
+
+    if (it == watchers->end())
+        return;
+
+    Callback *cb = it->callback;
+
+    if (cb->queued)
+        return;
+
+    cb->queued = true;
+    ++cb->refs;
+    _ready.append(cb);
+
+    wakeUp();
+}
+
+
+// Make sure the ready callbacks are run during the next iteration of the event
+// loop.
+void PyQtAsyncioScheduler::wakeUp()
+{
+    if (!_wakeup.isActive() || _wakeup.interval() != 0)
+        _wakeup.start(0);
+}
+
+
+// Arrange for run() to be called when the next callback is due.
+void PyQtAsyncioScheduler::reschedule()
+{
+    if (!_ready.isEmpty())
+    {
+        wakeUp();
+    }
+    else if (_timers.empty())
+    {
+        _wakeup.stop();
+    }
+    else
+    {
+        // Round up so that we aren't woken before the timer is due.
+        qint64 delay = (_timers.front().when - qpycore_now() + 999999) /
+                1000000;
+
+        if (delay < 0)
+            delay = 0;
+        else if (delay > std::numeric_limits<int>::max())
+            delay = std::numeric_limits<int>::max();
+
+        _wakeup.start(int(delay));
+    }
+}
+
+
+// Run one iteration of the scheduler.
+void PyQtAsyncioScheduler::run()
+{
+    ++_iterations;
+
+    // Add the callbacks scheduled from other threads.
+    _incoming_mutex.lock();
+    _ready.append(_incoming);
+    _incoming.clear();
+    _incoming_mutex.unlock();
+
+    // Add the timers that are due.
+    qint64 now_ns = qpycore_now();
+
+    while (!_timers.empty() && _timers.front().when <= now_ns)
+    {
+        std::pop_heap(_timers.begin(), _timers.end(), TimerLater());
+
+        Callback *cb = _timers.back().callback;
+        _timers.pop_back();
+
+        cb->in_heap = false;
+
+        // A cancelled callback has no Python objects to release.
+        if (cb->cancelled)
+        {
+            --_cancelled_timers;
+            release(cb);
+        }
+        else
+        {
+            _ready.append(cb);
+        }
+    }
+
+    if (!_ready.isEmpty() && sipGetInterpreter())
+    {
+        // Only run the callbacks that are ready now.  Any scheduled by the
+        // callbacks will be run during the next iteration.
+        QList<Callback *> ready;
+        ready.swap(_ready);
+
+        QPYCORE_BLOCK_THREADS("PyQtAsyncioScheduler::run()")
+
+        for (qsizetype i = 0; i < ready.size(); ++i)
+        {
+            Callback *cb = ready.at(i);
+
+            if (!cb->cancelled)
+            {
+                cb->queued = false;
+
+                // A one-shot callback can no longer be cancelled.
+                if (_handles.remove(cb->id))
+                    release(cb);
+
+                if (!invoke(cb))
+                {
+                    // Leave the rest until the next iteration, as asyncio
+                    // does when its loop is interrupted.
+                    release(cb);
+                    _ready = ready.mid(i + 1) + _ready;
+                    break;
+                }
+            }
+
+            release(cb);
+        }
+
+        QPYCORE_UNBLOCK_THREADS
+    }
+
+    reschedule();
+}
+
+
+// Invoke a callback and handle any exception.  Return false if the exception
+// wasn't an Exception, ie. a KeyboardInterrupt or SystemExit.  These are never
+// passed to the exception handler but are handled as if raised by a slot.  The
+// GIL must be held.
+bool PyQtAsyncioScheduler::invoke(Callback *cb)
+{
+    PyObject *res = PyObject_Call(cb->callable, cb->args, NULL);
+
+    if (res)
+    {
+        Py_DECREF(res);
+        return true;
+    }
+
+    if (!PyErr_ExceptionMatches(PyExc_Exception))
+    {
+        pyqt6_err_print();
+        return false;
+    }
+
+    if (_exception_handler)
+    {
+        PyObject *exception, *value, *traceback;
+
+        PyErr_Fetch(&exception, &value, &traceback);
+        PyErr_NormalizeException(&exception, &value, &traceback);
+
+        if (traceback)
+            PyException_SetTraceback(value, traceback);
+
+        res = PyObject_CallFunctionObjArgs(_exception_handler, value, NULL);
+
+        Py_XDECREF(exception);
+        Py_XDECREF(value);
+        Py_XDECREF(traceback);
+
+        if (res)
+        {
+            Py_DECREF(res);
+            return true;
+        }
+    }
+
+    pyqt6_err_print();
+
+    return true;
+}
@@ -0,0 +1,133 @@
+// This is the declaration of the PyQtAsyncioScheduler class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_PYQTASYNCIOSCHEDULER_H
+#define _QPYCORE_PYQTASYNCIOSCHEDULER_H
+
+
+#include <Python.h>
+
+#include <vector>
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QSocketNotifier>
+#include <QTimer>
+
+
+// This class implements the scheduling core of an asyncio event loop driven by
+// the Qt event dispatcher.  Timers are held in a heap and file descriptor
+// readiness and due timers are queued without the GIL.  All the callbacks that
+// are ready are then run with a single acquisition of the GIL.
+class PyQtAsyncioScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    PyQtAsyncioScheduler(QObject *parent = nullptr);
+    ~PyQtAsyncioScheduler();
+
+    static double time();
+
+    quint64 callSoon(PyObject *callback, PyObject *args, PyObject *context);
+    quint64 callSoonThreadsafe(PyObject *callback, PyObject *args,
+            PyObject *context);
+    quint64 callAt(double when, PyObject *callback, PyObject *args,
+            PyObject *context);
+    bool cancel(quint64 handle);
+
+    bool addReader(qintptr fd, PyObject *callback, PyObject *args,
+            PyObject *context);
+    bool removeReader(qintptr fd);
+    bool addWriter(qintptr fd, PyObject *callback, PyObject *args,
+            PyObject *context);
+    bool removeWriter(qintptr fd);
+
+    PyObject *exceptionHandler() const {return _exception_handler;}
+    void setExceptionHandler(PyObject *handler);
+
+    qsizetype readyCount() const {return _ready.size();}
+    qsizetype timerCount() const {return _timers.size();}
+    quint64 iterations() const {return _iterations;}
+
+private:
+    // A callback and its arguments.  It is shared by the containers that
+    // refer to it, each of which holds a reference.  The Python objects are
+    // released as soon as the callback is cancelled.
+    struct Callback {
+        quint64 id;
+        PyObject *callable;
+        PyObject *args;
+        int refs;
+        bool cancelled;
+        bool queued;
+        bool in_heap;
+    };
+
+    // A timer in the heap.
+    struct Timer {
+        qint64 when;
+        quint64 id;
+        Callback *callback;
+    };
+
+    // A file descriptor being watched.
+    struct Watcher {
+        QSocketNotifier *notifier;
+        Callback *callback;
+    };
+
+    QTimer _wakeup;
+    QList<Callback *> _ready;
+    std::vector<Timer> _timers;
+    size_t _cancelled_timers;
+    QHash<quint64, Callback *> _handles;
+    QHash<qintptr, Watcher> _readers;
+    QHash<qintptr, Watcher> _writers;
+    quint64 _next_id;
+    quint64 _iterations;
+    PyObject *_exception_handler;
+
+    // Callbacks scheduled from other threads.
+    QMutex _incoming_mutex;
+    QList<Callback *> _incoming;
+
+    Callback *newCallback(PyObject *callback, PyObject *args,
+            PyObject *context);
+    void release(Callback *cb);
+    void purgeCancelledTimers();
+    bool addWatcher(QHash<qintptr, Watcher> &watchers, qintptr fd,
+            QSocketNotifier::Type type, PyObject *callback, PyObject *args,
+            PyObject *context);
+    bool removeWatcher(QHash<qintptr, Watcher> &watchers, qintptr fd);
+    void activated(QHash<qintptr, Watcher> *watchers, qintptr fd);
+    void wakeUp();
+    void reschedule();
+    void run();
+    bool invoke(Callback *cb);
+
+    PyQtAsyncioScheduler(const PyQtAsyncioScheduler &);
+};
+
+
+#endif
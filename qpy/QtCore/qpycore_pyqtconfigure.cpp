@@ -21,7 +21,9 @@
 #include <Python.h>
 
 #include <QByteArray>
+#include <QHash>
 #include <QMetaObject>
+#include <QMetaProperty>
 #include <QObject>
 #include <QVariant>
 
@@ -29,6 +31,8 @@
 #include "qpycore_chimera.h"
 #include "qpycore_misc.h"
 #include "qpycore_pyqtboundsignal.h"
+#include "qpycore_pyqtsignal.h"
+#include "qpycore_types.h"
 
 #include "sipAPIQtCore.h"
 
@@ -44,6 +48,10 @@ enum ArgStatus
 
 static ArgStatus handle_argument(PyObject *self, QObject *qobj,
         PyObject *name_obj, PyObject *value_obj);
+static PyObject *resolve_argument(PyObject *self, const QMetaObject *mo,
+        PyObject *name_obj);
+static PyObject *resolve_uncached(PyObject *self, const QMetaObject *mo,
+        PyObject *name_obj);
 
 
 // This is the helper for QObject.pyqtConfigure().
@@ -100,8 +108,10 @@ int qpycore_qobject_finalisation(PyObject *self, QObject *qobj, PyObject *kwds,
     if (!kwds)
         return 0;
 
-    // The dict we will be removing handled arguments from, 0 if it needs to be
-    // created.
+    // The dict of unused arguments.  If the caller doesn't want one then we
+    // remove handled arguments from the original.  Otherwise it is only
+    // created (containing just the unhandled arguments) when the first
+    // argument is handled, as typically all of them will be.
     PyObject *unused = (updated_kwds ? 0 : kwds);
 
     PyObject *name_obj, *value_obj;
@@ -109,27 +119,61 @@ int qpycore_qobject_finalisation(PyObject *self, QObject *qobj, PyObject *kwds,
 
     while (PyDict_Next(kwds, &pos, &name_obj, &value_obj))
     {
+        Py_ssize_t this_pos = pos;
+
         ArgStatus as = handle_argument(self, qobj, name_obj, value_obj);
 
         if (as == AsError)
+        {
+            if (updated_kwds && unused)
+            {
+                Py_DECREF(unused);
+                *updated_kwds = 0;
+            }
+
             return -1;
+        }
 
         if (as == AsHandled)
         {
             if (!unused)
             {
-                unused = PyDict_Copy(kwds);
+                unused = PyDict_New();
 
                 if (!unused)
                     return -1;
 
                 *updated_kwds = unused;
-            }
 
-            if (PyDict_DelItem(unused, name_obj) < 0)
+                // Add any unhandled arguments we have already seen.
+                PyObject *prev_name_obj, *prev_value_obj;
+                Py_ssize_t prev_pos = 0;
+
+                while (PyDict_Next(kwds, &prev_pos, &prev_name_obj,
+                            &prev_value_obj) && prev_pos < this_pos)
+                {
+                    if (PyDict_SetItem(unused, prev_name_obj,
+                                prev_value_obj) < 0)
+                    {
+                        Py_DECREF(unused);
+                        *updated_kwds = 0;
+
+                        return -1;
+                    }
+                }
+            }
+            else if (!updated_kwds)
             {
-                if (updated_kwds)
-                    Py_DECREF(unused);
+                if (PyDict_DelItem(unused, name_obj) < 0)
+                    return -1;
+            }
+        }
+        else if (unused && updated_kwds)
+        {
+            if (PyDict_SetItem(unused, name_obj, value_obj) < 0)
+            {
+                Py_DECREF(unused);
+                *updated_kwds = 0;
 
                 return -1;
             }
@@ -146,18 +190,16 @@ static ArgStatus handle_argument(PyObject *self, QObject *qobj,
 {
     const QMetaObject *mo = qobj->metaObject();
 
-    // Get the name encoded name.
-    QByteArray enc_name = qpycore_convert_ASCII(name_obj);
+    PyObject *resolved = resolve_argument(self, mo, name_obj);
 
-    if (enc_name.isNull())
+    if (!resolved)
         return AsError;
 
-    // See if it is a property.
-    int idx = mo->indexOfProperty(enc_name.constData());
+    ArgStatus as = AsHandled;
 
-    if (idx >= 0)
+    if (PyLong_Check(resolved))
     {
-        QMetaProperty prop = mo->property(idx);
+        QMetaProperty prop = mo->property(PyLong_AsLong(resolved));
 
         // A negative type means a QVariant property.
         if (prop.userType() >= 0)
@@ -165,10 +207,10 @@ static ArgStatus handle_argument(PyObject *self, QObject *qobj,
             bool ok;
             QVariant value = qpycore_PyObject_AsQVariant(prop, value_obj, &ok);
 
-            if (!ok)
-                return AsError;
-
-            qobj->setProperty(enc_name.constData(), value);
+            if (ok)
+                prop.write(qobj, std::move(value));
+            else
+                as = AsError;
         }
         else
         {
@@ -179,61 +221,170 @@ static ArgStatus handle_argument(PyObject *self, QObject *qobj,
                             SIP_NOT_NONE, &value_state, &iserr));
 
             if (iserr)
-                return AsError;
+            {
+                as = AsError;
+            }
+            else
+            {
+                prop.write(qobj, *value);
+
+                sipReleaseType(value, sipType_QVariant, value_state);
+            }
+        }
+    }
+    else if (resolved != Py_None)
+    {
+        // It is a signal so make sure it is bound and connect the slot.
+        static PyObject *connect_obj = NULL;
 
-            qobj->setProperty(enc_name.constData(), *value);
+        if (!connect_obj)
+            connect_obj = PyUnicode_FromString("connect");
 
-            sipReleaseType(value, sipType_QVariant, value_state);
+        PyObject *sig;
+
+        if (!connect_obj)
+        {
+            sig = 0;
+        }
+        else if (PyObject_TypeCheck(resolved,
+                        qpycore_pyqtBoundSignal_TypeObject))
+        {
+            sig = resolved;
+            Py_INCREF(sig);
         }
+        else
+        {
+            sig = qpycore_pyqtBoundSignal_New((qpycore_pyqtSignal *)resolved,
+                    self, qobj);
+        }
+
+        PyObject *res = (sig ?
+                PyObject_CallMethodObjArgs(sig, connect_obj, value_obj, 0) :
+                0);
+
+        if (res)
+            Py_DECREF(res);
+        else
+            as = AsError;
+
+        Py_XDECREF(sig);
     }
     else
     {
-        bool unknown = true;
+        as = AsUnknown;
+    }
 
-        // See if it is a signal.
-        PyObject *sig = PyObject_GetAttr(self, name_obj);
+    Py_DECREF(resolved);
 
-        if (sig)
-        {
-            if (PyObject_TypeCheck(sig, qpycore_pyqtBoundSignal_TypeObject))
-            {
-                static PyObject *connect_obj = NULL;
+    return as;
+}
 
-                if (!connect_obj)
-                {
-                    connect_obj = PyUnicode_FromString("connect");
 
-                    if (!connect_obj)
-                    {
-                        Py_DECREF(sig);
-                        return AsError;
-                    }
-                }
+// Resolve a keyword argument name to the index of a property (as an int), a
+// signal or None.  A new reference is returned or 0 if there was an
+// error.  The result is cached in a dict for each meta-object.  Keyword
+// argument names are almost always interned so the lookup is usually just a
+// pointer comparison.  Only the meta-objects owned by PyQt (i.e. the static
+// meta-object of a wrapped class or the dynamic meta-object of a Python
+// sub-class) are cached as these are never deleted and so the cache keys are
+// never reused.  Others (e.g. the per-instance meta-objects created by QML)
+// are resolved every time.
+static PyObject *resolve_argument(PyObject *self, const QMetaObject *mo,
+        PyObject *name_obj)
+{
+    if (mo != qpycore_get_qmetaobject((sipWrapperType *)Py_TYPE(self)))
+        return resolve_uncached(self, mo, name_obj);
 
-                // Connect the slot.
-                PyObject *res = PyObject_CallMethodObjArgs(sig, connect_obj,
-                        value_obj, 0);
+    typedef QHash<const QMetaObject *, PyObject *> ResolutionCache;
 
-                if (!res)
-                {
-                    Py_DECREF(sig);
-                    return AsError;
-                }
+    static ResolutionCache *cache = 0;
 
-                Py_DECREF(res);
+    if (!cache)
+        cache = new ResolutionCache;
 
-                unknown = false;
-            }
+    PyObject *names = cache->value(mo);
 
-            Py_DECREF(sig);
-        }
+    if (!names)
+    {
+        names = PyDict_New();
+
+        if (!names)
+            return 0;
+
+        cache->insert(mo, names);
+    }
+
+    PyObject *resolved = PyDict_GetItemWithError(names, name_obj);
+
+    if (resolved)
+    {
+        Py_INCREF(resolved);
+        return resolved;
+    }
+
+    if (PyErr_Occurred())
+        return 0;
+
+    resolved = resolve_uncached(self, mo, name_obj);
+
+    // A bound signal is specific to the object and isn't cached.
+    if (!resolved ||
+            PyObject_TypeCheck(resolved, qpycore_pyqtBoundSignal_TypeObject))
+        return resolved;
+
+    if (PyDict_SetItem(names, name_obj, resolved) < 0)
+    {
+        Py_DECREF(resolved);
+        return 0;
+    }
+
+    return resolved;
+}
 
-        if (unknown)
+
+// Resolve a keyword argument name without using the cache.
+static PyObject *resolve_uncached(PyObject *self, const QMetaObject *mo,
+        PyObject *name_obj)
+{
+    // See if it is a property.
+    QByteArray enc_name = qpycore_convert_ASCII(name_obj);
+
+    if (enc_name.isNull())
+        return 0;
+
+    int idx = mo->indexOfProperty(enc_name.constData());
+
+    if (idx >= 0)
+        return PyLong_FromLong(idx);
+
+    // See if it is a signal.
+    PyObject *sig = PyObject_GetAttr(self, name_obj);
+
+    if (sig)
+    {
+        if (PyObject_TypeCheck(sig, qpycore_pyqtBoundSignal_TypeObject))
         {
-            PyErr_Clear();
-            return AsUnknown;
+            qpycore_pyqtBoundSignal *bs = (qpycore_pyqtBoundSignal *)sig;
+
+            // A signal bound to a different object is returned as it is.
+            if (bs->bound_pyobject != self)
+                return sig;
+
+            PyObject *unbound = (PyObject *)bs->unbound_signal;
+
+            Py_INCREF(unbound);
+            Py_DECREF(sig);
+
+            return unbound;
         }
+
+        Py_DECREF(sig);
+    }
+    else
+    {
+        PyErr_Clear();
     }
 
-    return AsHandled;
+    Py_INCREF(Py_None);
+    return Py_None;
 }
@@ -0,0 +1,45 @@
+// This is the declaration of the PyQtConstByteArray class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_PYQTCONSTBYTEARRAY_H
+#define _QPYCORE_PYQTCONSTBYTEARRAY_H
+
+
+#include <QByteArray>
+
+
+// This class holds an implicitly shared copy of a QByteArray and exports its
+// data as a read-only buffer.  Unlike QByteArray's own buffer, exporting it
+// never causes the data to be detached and copied.
+class PyQtConstByteArray
+{
+public:
+    PyQtConstByteArray(const QByteArray &ba) : _ba(ba) {}
+
+    const char *constData() const {return _ba.constData();}
+    qsizetype size() const {return _ba.size();}
+
+private:
+    QByteArray _ba;
+};
+
+
+#endif
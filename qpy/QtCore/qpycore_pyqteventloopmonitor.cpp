@@ -0,0 +1,691 @@
+// This is the implementation of the PyQtEventLoopMonitor class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <Python.h>
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "qpycore_api.h"
+#include "qpycore_pyqteventloopmonitor.h"
+#include "qpycore_pyqtslot.h"
+
+#include "sipAPIQtCore.h"
+
+
+// The thread that checks if the current iteration of a monitor's event loop
+// has exceeded the threshold.
+class PyQtEventLoopWatchdog : public QThread
+{
+public:
+    PyQtEventLoopWatchdog(PyQtEventLoopMonitor *monitor) : _monitor(monitor),
+            _stopping(false) {}
+
+    void stop();
+
+protected:
+    void run() override;
+
+private:
+    PyQtEventLoopMonitor *_monitor;
+    QMutex _mutex;
+    QWaitCondition _wake;
+    bool _stopping;
+};
+
+
+// Stop the thread and wait for it to finish.  This may be called with or
+// without the GIL.
+void PyQtEventLoopWatchdog::stop()
+{
+    _mutex.lock();
+    _stopping = true;
+    _wake.wakeAll();
+    _mutex.unlock();
+
+    if (!Py_IsInitialized())
+    {
+        wait();
+        return;
+    }
+
+    // The thread may be waiting for the GIL so make sure it isn't held while
+    // waiting.  The monitor may be destroyed with the GIL held, for example as
+    // the child of an object owned by Python.
+    PyGILState_STATE gil = PyGILState_Ensure();
+    PyThreadState *tstate = PyEval_SaveThread();
+
+    wait();
+
+    PyEval_RestoreThread(tstate);
+    PyGILState_Release(gil);
+}
+
+
+// Check the monitor four times per threshold until stopped.
+void PyQtEventLoopWatchdog::run()
+{
+    QMutexLocker locker(&_mutex);
+
+    while (!_stopping)
+    {
+        _wake.wait(&_mutex, qMax(_monitor->threshold() / 4, 1));
+
+        if (_stopping)
+            break;
+
+        locker.unlock();
+        _monitor->check();
+        locker.relock();
+    }
+}
+
+
+// The association of a monitor with the thread it is monitoring.  It belongs
+// to the thread so that a monitor that is destroyed in another thread can
+// dissociate itself by clearing the monitor, with the GIL held.  The thread
+// then discards the binding when it next looks for its monitor.
+struct PyQtEventLoopMonitorBinding
+{
+    PyQtEventLoopMonitor *monitor;
+};
+
+
+// The binding of each thread.
+static thread_local PyQtEventLoopMonitorBinding *current_binding = nullptr;
+
+
+// Forward declarations.
+static PyObject *histogram_list(const std::atomic<qint64> *histogram);
+
+
+// Create the monitor.
+PyQtEventLoopMonitor::PyQtEventLoopMonitor(QObject *parent) : QObject(parent),
+        _active(false), _binding(nullptr), _binding_thread(nullptr),
+        _watchdog(nullptr), _watchdog_callable(0),
+        _threshold(50000000), _iteration_start(0), _iteration_serial(0),
+        _current_slot(nullptr), _reported_serial(0), _iteration_python(0),
+        _iteration_slowest(0)
+{
+    reset();
+}
+
+
+// Destroy the monitor.  This may be called in any thread with or without the
+// GIL.
+PyQtEventLoopMonitor::~PyQtEventLoopMonitor()
+{
+    stop();
+
+    if (_watchdog_callable && Py_IsInitialized())
+    {
+        QPYCORE_BLOCK_THREADS("PyQtEventLoopMonitor::~PyQtEventLoopMonitor()")
+        Py_DECREF(_watchdog_callable);
+        QPYCORE_UNBLOCK_THREADS
+    }
+}
+
+
+// Start monitoring the event loop of the current thread.  This is called with
+// the GIL.
+bool PyQtEventLoopMonitor::start()
+{
+    if (_active)
+        return true;
+
+    if (thread() != QThread::currentThread())
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+                "a monitor must be started in the thread it lives in");
+        return false;
+    }
+
+    if (current())
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+                "the event loop of the current thread is already being "
+                "monitored");
+        return false;
+    }
+
+    QAbstractEventDispatcher *dispatcher =
+            QAbstractEventDispatcher::instance();
+
+    if (!dispatcher)
+    {
+        PyErr_SetString(PyExc_RuntimeError,
+                "the current thread does not have an event dispatcher");
+        return false;
+    }
+
+    _active = true;
+    _dispatcher = dispatcher;
+
+    _binding = new PyQtEventLoopMonitorBinding;
+    _binding->monitor = this;
+    _binding_thread = QThread::currentThread();
+    current_binding = _binding;
+
+    connect(dispatcher, &QAbstractEventDispatcher::awake, this,
+            &PyQtEventLoopMonitor::awake, Qt::DirectConnection);
+    connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this,
+            &PyQtEventLoopMonitor::aboutToBlock, Qt::DirectConnection);
+
+    // Application event filters only see the events delivered in the main
+    // thread so the backlog isn't available for other threads.
+    QCoreApplication *app = QCoreApplication::instance();
+
+    if (app && app->thread() == QThread::currentThread())
+        app->installEventFilter(this);
+
+    // We are being called from Python so an iteration is in progress.
+    awake();
+
+    if (_watchdog_callable)
+        startWatchdog();
+
+    return true;
+}
+
+
+// Stop monitoring.  This must be called from the monitored thread, or when the
+// monitor is being destroyed, with or without the GIL.
+void PyQtEventLoopMonitor::stop()
+{
+    if (!_active)
+        return;
+
+    if (_watchdog)
+    {
+        _watchdog->stop();
+        delete _watchdog;
+        _watchdog = nullptr;
+    }
+
+    QCoreApplication *app = QCoreApplication::instance();
+
+    if (app)
+        app->removeEventFilter(this);
+
+    if (_dispatcher)
+        disconnect(_dispatcher, nullptr, this, nullptr);
+
+    _active = false;
+    _dispatcher = nullptr;
+    _iteration_start.store(0, std::memory_order_relaxed);
+    _current_slot.store(nullptr, std::memory_order_relaxed);
+
+    unbind();
+}
+
+
+// Return the monitor of the current thread.
+PyQtEventLoopMonitor *PyQtEventLoopMonitor::current()
+{
+    PyQtEventLoopMonitorBinding *binding = current_binding;
+
+    if (!binding)
+        return nullptr;
+
+    if (!binding->monitor)
+    {
+        // The monitor was destroyed in another thread.
+        current_binding = nullptr;
+        delete binding;
+
+        return nullptr;
+    }
+
+    return binding->monitor;
+}
+
+
+// Dissociate the monitor from the thread it is monitoring.
+void PyQtEventLoopMonitor::unbind()
+{
+    if (!_binding)
+        return;
+
+    if (QThread::currentThread() == _binding_thread)
+    {
+        if (current_binding == _binding)
+            current_binding = nullptr;
+
+        delete _binding;
+    }
+    else if (Py_IsInitialized())
+    {
+        // Slot proxies only use the binding with the GIL.
+        QPYCORE_BLOCK_THREADS("PyQtEventLoopMonitor::unbind()")
+        _binding->monitor = nullptr;
+        QPYCORE_UNBLOCK_THREADS
+    }
+    else
+    {
+        _binding->monitor = nullptr;
+    }
+
+    _binding = nullptr;
+    _binding_thread = nullptr;
+}
+
+
+// Return the threshold in milliseconds.
+int PyQtEventLoopMonitor::threshold() const
+{
+    return int(_threshold.load(std::memory_order_relaxed) / 1000000);
+}
+
+
+// Set the threshold in milliseconds.  An iteration that takes at least this
+// long is counted as a stall, is attributed to its slowest slot and causes the
+// watchdog to be called.
+void PyQtEventLoopMonitor::setThreshold(int msecs)
+{
+    _threshold.store(qint64(qMax(msecs, 1)) * 1000000,
+            std::memory_order_relaxed);
+}
+
+
+// Set the callable that is called from the watchdog thread, with the GIL, when
+// an iteration exceeds the threshold.  It is passed the time the iteration has
+// taken so far and the qualified name of the slot being invoked, if any.  This
+// is called with the GIL.
+void PyQtEventLoopMonitor::setWatchdog(PyObject *callable)
+{
+    if (callable == Py_None)
+        callable = 0;
+
+    Py_XINCREF(callable);
+    Py_XDECREF(_watchdog_callable);
+    _watchdog_callable = callable;
+
+    // The watchdog thread is created when first needed and runs until the
+    // monitor is stopped.
+    if (_active && _watchdog_callable)
+        startWatchdog();
+}
+
+
+// Discard all statistics.
+void PyQtEventLoopMonitor::reset()
+{
+    QMutexLocker locker(&_mutex);
+
+    _iterations.store(0, std::memory_order_relaxed);
+    _busy_total.store(0, std::memory_order_relaxed);
+    _python_total.store(0, std::memory_order_relaxed);
+    _max_latency.store(0, std::memory_order_relaxed);
+    _stalls.store(0, std::memory_order_relaxed);
+
+    for (int i = 0; i < QPYCORE_NR_BUCKETS; ++i)
+    {
+        _latency_histogram[i].store(0, std::memory_order_relaxed);
+        _python_histogram[i].store(0, std::memory_order_relaxed);
+    }
+
+    _backlog.clear();
+    _slow_handlers.clear();
+}
+
+
+// Return the number of iterations, the total time spent in iterations, in
+// Python slots and in C++, the maximum latency and the number of stalls.
+PyObject *PyQtEventLoopMonitor::statistics() const
+{
+    qint64 busy = _busy_total.load(std::memory_order_relaxed);
+    qint64 python = _python_total.load(std::memory_order_relaxed);
+
+    return Py_BuildValue("(LddddL)",
+            (long long)_iterations.load(std::memory_order_relaxed),
+            busy / 1.0e9, python / 1.0e9,
+            qMax(busy - python, qint64(0)) / 1.0e9,
+            _max_latency.load(std::memory_order_relaxed) / 1.0e9,
+            (long long)_stalls.load(std::memory_order_relaxed));
+}
+
+
+// Return the histograms of the latency of each iteration and the time it spent
+// in Python slots.
+PyObject *PyQtEventLoopMonitor::histograms() const
+{
+    PyObject *latency = histogram_list(_latency_histogram);
+
+    if (!latency)
+        return 0;
+
+    PyObject *python = histogram_list(_python_histogram);
+
+    if (!python)
+    {
+        Py_DECREF(latency);
+        return 0;
+    }
+
+    PyObject *res = PyTuple_Pack(2, latency, python);
+
+    Py_DECREF(latency);
+    Py_DECREF(python);
+
+    return res;
+}
+
+
+// Return the number of events delivered to each receiver type and the maximum
+// delivered in a single iteration.
+PyObject *PyQtEventLoopMonitor::backlog() const
+{
+    PyObject *res = PyList_New(0);
+
+    if (!res)
+        return 0;
+
+    QMutexLocker locker(&_mutex);
+
+    for (const Backlog &b : _backlog)
+    {
+        PyObject *entry = Py_BuildValue("(sLL)", b.class_name.constData(),
+                (long long)b.events, (long long)b.max);
+
+        if (!entry || PyList_Append(res, entry) < 0)
+        {
+            Py_XDECREF(entry);
+            Py_DECREF(res);
+            return 0;
+        }
+
+        Py_DECREF(entry);
+    }
+
+    return res;
+}
+
+
+// Return the slots that were the slowest in an iteration that exceeded the
+// threshold, the number of such iterations and the maximum time of the slot.
+PyObject *PyQtEventLoopMonitor::slowHandlers() const
+{
+    PyObject *res = PyList_New(0);
+
+    if (!res)
+        return 0;
+
+    QMutexLocker locker(&_mutex);
+
+    for (auto it = _slow_handlers.cbegin(); it != _slow_handlers.cend(); ++it)
+    {
+        PyObject *entry = Py_BuildValue("(sLd)", it.key().constData(),
+                (long long)it.value().count, it.value().max / 1.0e9);
+
+        if (!entry || PyList_Append(res, entry) < 0)
+        {
+            Py_XDECREF(entry);
+            Py_DECREF(res);
+            return 0;
+        }
+
+        Py_DECREF(entry);
+    }
+
+    return res;
+}
+
+
+// Record the start of the invocation of a slot by a slot proxy.  The slot that
+// it is nested in, if any, is returned so that it can be restored.  This is
+// called with the GIL.
+qint64 PyQtEventLoopMonitor::handlerStarted(const PyQtSlot *slot,
+        const PyQtSlot **outer)
+{
+    *outer = _current_slot.exchange(slot, std::memory_order_acq_rel);
+
+    return qpycore_now();
+}
+
+
+// Record the end of the invocation of a slot by a slot proxy.  This is called
+// with the GIL.
+void PyQtEventLoopMonitor::handlerFinished(const PyQtSlot *slot,
+        const PyQtSlot *outer, qint64 start)
+{
+    qint64 elapsed = qpycore_now() - start;
+
+    _current_slot.store(outer, std::memory_order_release);
+
+    // The time of a nested slot is included in the time of the outermost one.
+    if (!outer)
+        _iteration_python += elapsed;
+
+    if (elapsed > _iteration_slowest)
+    {
+        _iteration_slowest = elapsed;
+
+        // Naming the slot is relatively expensive so it is only done if it
+        // could be responsible for exceeding the threshold.
+        if (elapsed * 10 >= _threshold.load(std::memory_order_relaxed))
+            _iteration_slowest_name = slot->qualifiedName();
+        else
+            _iteration_slowest_name.clear();
+    }
+}
+
+
+// Check if the current iteration has exceeded the threshold and, if so, call
+// the watchdog once for the iteration.  This is called from the watchdog
+// thread without the GIL.
+void PyQtEventLoopMonitor::check()
+{
+    quint64 serial = _iteration_serial.load(std::memory_order_acquire);
+    qint64 start = _iteration_start.load(std::memory_order_acquire);
+
+    if (start == 0 || serial == _reported_serial)
+        return;
+
+    // Make sure the start time belongs to the iteration.
+    if (_iteration_serial.load(std::memory_order_acquire) != serial)
+        return;
+
+    qint64 latency = qpycore_now() - start;
+
+    if (latency < _threshold.load(std::memory_order_relaxed))
+        return;
+
+    _reported_serial = serial;
+
+    QPYCORE_BLOCK_THREADS("PyQtEventLoopMonitor::check()")
+
+    PyObject *callable = _watchdog_callable;
+
+    if (callable)
+    {
+        Py_INCREF(callable);
+
+        // The slot cannot be destroyed while we hold the GIL.
+        const PyQtSlot *slot = _current_slot.load(std::memory_order_acquire);
+        PyObject *handler;
+
+        if (slot)
+        {
+            QByteArray name = slot->qualifiedName();
+
+            handler = PyUnicode_FromStringAndSize(name.constData(),
+                    name.size());
+        }
+        else
+        {
+            handler = Py_None;
+            Py_INCREF(handler);
+        }
+
+        PyObject *res = (handler ?
+                PyObject_CallFunction(callable, "dO", latency / 1.0e9,
+                        handler) :
+                0);
+
+        Py_XDECREF(handler);
+
+        if (res)
+            Py_DECREF(res);
+        else
+            pyqt6_err_print();
+
+        Py_DECREF(callable);
+    }
+
+    QPYCORE_UNBLOCK_THREADS
+}
+
+
+// Count the events delivered to each receiver type during an iteration.
+bool PyQtEventLoopMonitor::eventFilter(QObject *watched, QEvent *)
+{
+    if (_iteration_start.load(std::memory_order_relaxed) != 0)
+        ++_iteration_events[watched->metaObject()];
+
+    return false;
+}
+
+
+// Handle the event dispatcher waking.  The dispatcher may wake several times
+// before it next blocks and they are all treated as a single iteration.
+void PyQtEventLoopMonitor::awake()
+{
+    if (_iteration_start.load(std::memory_order_relaxed) != 0)
+        return;
+
+    _iteration_python = 0;
+    _iteration_slowest = 0;
+    _iteration_slowest_name.clear();
+
+    _iteration_serial.fetch_add(1, std::memory_order_relaxed);
+    _iteration_start.store(qpycore_now(), std::memory_order_release);
+}
+
+
+// Handle the event dispatcher being about to block by recording the iteration
+// that has just finished.
+void PyQtEventLoopMonitor::aboutToBlock()
+{
+    qint64 start = _iteration_start.load(std::memory_order_relaxed);
+
+    if (start == 0)
+        return;
+
+    qint64 latency = qpycore_now() - start;
+
+    _iteration_start.store(0, std::memory_order_relaxed);
+
+    _iterations.fetch_add(1, std::memory_order_relaxed);
+    _busy_total.fetch_add(latency, std::memory_order_relaxed);
+    _python_total.fetch_add(_iteration_python, std::memory_order_relaxed);
+    _latency_histogram[qpycore_bucket(latency)].fetch_add(1,
+            std::memory_order_relaxed);
+    _python_histogram[qpycore_bucket(_iteration_python)].fetch_add(1,
+            std::memory_order_relaxed);
+
+    // This is the only thread that updates the maximum (apart from a reset).
+    if (latency > _max_latency.load(std::memory_order_relaxed))
+        _max_latency.store(latency, std::memory_order_relaxed);
+
+    bool stalled = (latency >= _threshold.load(std::memory_order_relaxed));
+
+    if (stalled)
+        _stalls.fetch_add(1, std::memory_order_relaxed);
+
+    if (_iteration_events.isEmpty() && !stalled)
+        return;
+
+    QMutexLocker locker(&_mutex);
+
+    // The receiver types are kept so that the hash doesn't need to be rebuilt
+    // for every iteration.
+    for (auto it = _iteration_events.begin(); it != _iteration_events.end();
+            ++it)
+    {
+        qint64 events = it.value();
+
+        if (events == 0)
+            continue;
+
+        Backlog &b = _backlog[it.key()];
+
+        if (b.class_name.isEmpty())
+            b.class_name = it.key()->className();
+
+        b.events += events;
+
+        if (b.max < events)
+            b.max = events;
+
+        it.value() = 0;
+    }
+
+    if (stalled && !_iteration_slowest_name.isEmpty())
+    {
+        SlowHandler &h = _slow_handlers[_iteration_slowest_name];
+
+        ++h.count;
+
+        if (h.max < _iteration_slowest)
+            h.max = _iteration_slowest;
+    }
+}
+
+
+// Start the watchdog thread if it isn't already running.
+void PyQtEventLoopMonitor::startWatchdog()
+{
+    if (_watchdog)
+        return;
+
+    _watchdog = new PyQtEventLoopWatchdog(this);
+    _watchdog->start();
+}
+
+
+// Return a histogram as a list.
+static PyObject *histogram_list(const std::atomic<qint64> *histogram)
+{
+    PyObject *list = PyList_New(QPYCORE_NR_BUCKETS);
+
+    if (!list)
+        return 0;
+
+    for (int i = 0; i < QPYCORE_NR_BUCKETS; ++i)
+    {
+        PyObject *count = PyLong_FromLongLong(
+                histogram[i].load(std::memory_order_relaxed));
+
+        if (!count)
+        {
+            Py_DECREF(list);
+            return 0;
+        }
+
+        PyList_SetItem(list, i, count);
+    }
+
+    return list;
+}
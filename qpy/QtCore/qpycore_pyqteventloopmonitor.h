@@ -0,0 +1,157 @@
+// This is the declaration of the PyQtEventLoopMonitor class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_PYQTEVENTLOOPMONITOR_H
+#define _QPYCORE_PYQTEVENTLOOPMONITOR_H
+
+
+#include <Python.h>
+
+#include <atomic>
+
+#include <QAbstractEventDispatcher>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QPointer>
+
+#include "qpycore_clock.h"
+
+
+QT_BEGIN_NAMESPACE
+class QEvent;
+class QThread;
+QT_END_NAMESPACE
+
+class PyQtEventLoopWatchdog;
+class PyQtSlot;
+struct PyQtEventLoopMonitorBinding;
+
+
+// This class monitors the latency of the event loop of the thread it lives
+// in.  An iteration starts when the event dispatcher wakes and ends when it is
+// about to block, so its length is the longest time that an event posted
+// during it may wait.  The time spent in Python slots invoked by slot proxies
+// is measured separately so that the time spent in C++ can be inferred, and
+// the slowest slot of each iteration that exceeds the threshold is recorded.
+// The histograms are updated without locks and may be read from any thread.
+// An optional watchdog thread calls a Python callable while an iteration is
+// exceeding the threshold.
+class PyQtEventLoopMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    PyQtEventLoopMonitor(QObject *parent = nullptr);
+    ~PyQtEventLoopMonitor();
+
+    bool start();
+    void stop();
+    bool isActive() const {return _active;}
+
+    int threshold() const;
+    void setThreshold(int msecs);
+
+    PyObject *watchdog() const {return _watchdog_callable;}
+    void setWatchdog(PyObject *callable);
+
+    void reset();
+    PyObject *statistics() const;
+    PyObject *histograms() const;
+    PyObject *backlog() const;
+    PyObject *slowHandlers() const;
+
+    // Return the monitor of the current thread.  This is called by slot
+    // proxies.  The GIL must be held as the monitor may be destroyed in
+    // another thread.
+    static PyQtEventLoopMonitor *current();
+
+    qint64 handlerStarted(const PyQtSlot *slot, const PyQtSlot **outer);
+    void handlerFinished(const PyQtSlot *slot, const PyQtSlot *outer,
+            qint64 start);
+
+    void check();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    // The events delivered to a receiver type.
+    struct Backlog {
+        Backlog() : events(0), max(0) {}
+
+        QByteArray class_name;
+        qint64 events;
+        qint64 max;
+    };
+
+    // The iterations for which a slot was the slowest.
+    struct SlowHandler {
+        SlowHandler() : count(0), max(0) {}
+
+        qint64 count;
+        qint64 max;
+    };
+
+    bool _active;
+    PyQtEventLoopMonitorBinding *_binding;
+    QThread *_binding_thread;
+    QPointer<QAbstractEventDispatcher> _dispatcher;
+    PyQtEventLoopWatchdog *_watchdog;
+    PyObject *_watchdog_callable;
+    std::atomic<qint64> _threshold;
+
+    // The state of the current iteration.  The start time is 0 when the event
+    // dispatcher is blocked.  The atomic members are also read by the
+    // watchdog thread, which is the only user of the serial number of the last
+    // iteration it reported.  Everything else is only used by the monitored
+    // thread.
+    std::atomic<qint64> _iteration_start;
+    std::atomic<quint64> _iteration_serial;
+    std::atomic<const PyQtSlot *> _current_slot;
+    quint64 _reported_serial;
+    qint64 _iteration_python;
+    qint64 _iteration_slowest;
+    QByteArray _iteration_slowest_name;
+    QHash<const QMetaObject *, qint64> _iteration_events;
+
+    // The statistics.
+    std::atomic<qint64> _iterations;
+    std::atomic<qint64> _busy_total;
+    std::atomic<qint64> _python_total;
+    std::atomic<qint64> _max_latency;
+    std::atomic<qint64> _stalls;
+    std::atomic<qint64> _latency_histogram[QPYCORE_NR_BUCKETS];
+    std::atomic<qint64> _python_histogram[QPYCORE_NR_BUCKETS];
+
+    mutable QMutex _mutex;
+    QHash<const QMetaObject *, Backlog> _backlog;
+    QHash<QByteArray, SlowHandler> _slow_handlers;
+
+    void awake();
+    void aboutToBlock();
+    void startWatchdog();
+    void unbind();
+};
+
+
+#endif
@@ -0,0 +1,386 @@
+// This is the implementation of the PyQtFileMapping class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <Python.h>
+
+#include <QFileDevice>
+#include <QMultiHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#if defined(Q_OS_UNIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#define QPYCORE_NATIVE_MAPPING
+#elif defined(Q_OS_WIN)
+#include <io.h>
+#include <windows.h>
+#define QPYCORE_NATIVE_MAPPING
+#endif
+
+#include "qpycore_pyqtfilemapping.h"
+
+
+// The valid mappings made by each file device.  These are removed by Qt when
+// the device is closed, possibly from C++ in another thread, so access is
+// protected by a mutex.
+static QMultiHash<QFileDevice *, PyQtFileMapping *> device_mappings;
+static QMutex device_mappings_mutex;
+
+
+#if defined(Q_OS_UNIX)
+// Return the size of a page.
+static quintptr page_size()
+{
+    static quintptr size = 0;
+
+    if (!size)
+        size = sysconf(_SC_PAGESIZE);
+
+    return size;
+}
+#endif
+
+
+// Create the mapping.  This is called with the GIL.  The Python object that
+// wraps the file device is kept alive for the lifetime of the mapping.
+PyQtFileMapping::PyQtFileMapping(QFileDevice *device, PyObject *device_wrapper,
+        qint64 offset, qint64 size, QFileDevice::MemoryMapFlags flags) :
+        _device(device), _device_key(device),
+        _device_wrapper(device_wrapper), _address(nullptr),
+        _size(size), _writable(false), _exports(0), _native_base(nullptr),
+        _native_size(0)
+{
+    Py_INCREF(_device_wrapper);
+
+    QIODevice::OpenMode mode = device->openMode();
+
+    // This mirrors the protection that Qt uses for the mapping.
+    _writable = ((mode & QIODevice::WriteOnly) ||
+            (flags & QFileDevice::MapPrivateOption));
+
+#if defined(QPYCORE_NATIVE_MAPPING)
+    int fd = device->handle();
+
+    if (fd != -1)
+    {
+        // Make sure that any buffered data is in the file.  Note that size()
+        // also does this.
+        qint64 file_size = device->size();
+
+        // Accessing a page beyond the end of the file raises a signal rather
+        // than an exception.
+        if (offset >= 0 && size > 0 && offset <= file_size - size)
+            mapNative(fd, offset, mode, flags);
+
+        return;
+    }
+#endif
+
+    _address = device->map(offset, size, flags);
+
+    if (!_address)
+        return;
+
+    QMutexLocker locker(&device_mappings_mutex);
+
+    device_mappings.insert(device, this);
+
+    // Qt removes all mappings when the file is closed.  Note that the mapping
+    // itself is not captured as it may be destroyed in another thread.
+    _about_to_close = QObject::connect(device, &QIODevice::aboutToClose,
+            [device]() {
+                deviceClosing(device);
+            });
+}
+
+
+// Destroy the mapping.  There can be no exported views as each holds a
+// reference to the mapping's Python object.
+PyQtFileMapping::~PyQtFileMapping()
+{
+    unmapAddress();
+
+    Py_DECREF(_device_wrapper);
+}
+
+
+// Explicitly remove the mapping.  Return false and raise an exception if
+// there are exported views.
+bool PyQtFileMapping::unmap()
+{
+    if (_exports > 0)
+    {
+        PyErr_SetString(PyExc_BufferError,
+                "cannot unmap while views of the mapping exist");
+        return false;
+    }
+
+    unmapAddress();
+
+    return true;
+}
+
+
+// Advise the operating system about how part of the mapping will be accessed.
+// A negative length means to the end of the mapping.  Return false if the
+// advice could not be given.
+bool PyQtFileMapping::advise(Advice advice, qint64 offset, qint64 length)
+{
+    if (!_address || offset < 0 || offset > _size)
+        return false;
+
+    if (length < 0 || length > _size - offset)
+        length = _size - offset;
+
+#if defined(Q_OS_UNIX)
+    int posix_advice;
+
+    switch (advice)
+    {
+    case SequentialAccess:
+        posix_advice = MADV_SEQUENTIAL;
+        break;
+
+    case RandomAccess:
+        posix_advice = MADV_RANDOM;
+        break;
+
+    case WillNeed:
+        posix_advice = MADV_WILLNEED;
+        break;
+
+    case DontNeed:
+        posix_advice = MADV_DONTNEED;
+        break;
+
+    default:
+        posix_advice = MADV_NORMAL;
+    }
+
+    // The address Qt returns is not necessarily page aligned.
+    quintptr start = reinterpret_cast<quintptr>(_address) + offset;
+    quintptr aligned = start & ~(page_size() - 1);
+
+    return (madvise(reinterpret_cast<void *>(aligned),
+            length + (start - aligned), posix_advice) == 0);
+#else
+    Q_UNUSED(advice);
+
+    return false;
+#endif
+}
+
+
+// Get the details of the mapping for a new exported view.  Return -1 and raise
+// an exception if there is no mapping.
+int PyQtFileMapping::getBuffer(void **buf, Py_ssize_t *len, int *readonly)
+{
+    QMutexLocker locker(&device_mappings_mutex);
+
+    if (!_address)
+    {
+        PyErr_SetString(PyExc_ValueError, "the mapping has been removed");
+        return -1;
+    }
+
+    *buf = _address;
+    *len = _size;
+    *readonly = !_writable;
+
+    ++_exports;
+
+    return 0;
+}
+
+
+// Release an exported view.
+void PyQtFileMapping::releaseBuffer()
+{
+    if (_exports > 0)
+        --_exports;
+}
+
+
+// Check that a file device can be closed from Python.  Return false and raise
+// an exception if any of the mappings it made have exported views.  Native
+// mappings are not affected by the device being closed.
+bool PyQtFileMapping::canClose(QFileDevice *device)
+{
+    QMutexLocker locker(&device_mappings_mutex);
+
+    const auto mappings = device_mappings.values(device);
+
+    for (PyQtFileMapping *mapping : mappings)
+    {
+        if (mapping->_exports > 0)
+        {
+            PyErr_SetString(PyExc_BufferError,
+                    "cannot close the file while views of a mapping exist");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+#if defined(QPYCORE_NATIVE_MAPPING)
+// Map the file directly so that the mapping does not depend on the device
+// remaining open.  This mirrors what Qt does for the same arguments.
+bool PyQtFileMapping::mapNative(int fd, qint64 offset,
+        QIODevice::OpenMode mode, QFileDevice::MemoryMapFlags flags)
+{
+#if defined(Q_OS_UNIX)
+    int prot = 0;
+
+    if (mode & QIODevice::ReadOnly)
+        prot |= PROT_READ;
+
+    if (mode & QIODevice::WriteOnly)
+        prot |= PROT_WRITE;
+
+    int share = MAP_SHARED;
+
+    if (flags & QFileDevice::MapPrivateOption)
+    {
+        share = MAP_PRIVATE;
+        prot |= PROT_WRITE;
+    }
+
+    qint64 aligned = offset & ~qint64(page_size() - 1);
+    size_t length = _size + (offset - aligned);
+
+    void *base = mmap(nullptr, length, prot, share, fd, aligned);
+
+    if (base == MAP_FAILED)
+        return false;
+#else
+    HANDLE fh = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+
+    if (fh == INVALID_HANDLE_VALUE)
+        return false;
+
+    DWORD protect, access;
+
+    if (flags & QFileDevice::MapPrivateOption)
+    {
+        protect = PAGE_WRITECOPY;
+        access = FILE_MAP_COPY;
+    }
+    else if (mode & QIODevice::WriteOnly)
+    {
+        protect = PAGE_READWRITE;
+        access = FILE_MAP_WRITE;
+    }
+    else
+    {
+        protect = PAGE_READONLY;
+        access = FILE_MAP_READ;
+    }
+
+    HANDLE mh = CreateFileMappingW(fh, nullptr, protect, 0, 0, nullptr);
+
+    if (!mh)
+        return false;
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    qint64 aligned = offset - offset % info.dwAllocationGranularity;
+    size_t length = _size + (offset - aligned);
+
+    void *base = MapViewOfFile(mh, access, DWORD(quint64(aligned) >> 32),
+            DWORD(aligned & 0xffffffff), length);
+
+    // The view keeps the mapping object alive.
+    CloseHandle(mh);
+
+    if (!base)
+        return false;
+#endif
+
+    _native_base = base;
+    _native_size = length;
+    _address = static_cast<uchar *>(base) + (offset - aligned);
+
+    return true;
+}
+#endif
+
+
+// Remove the mapping if it is still valid.
+void PyQtFileMapping::unmapAddress()
+{
+    if (_native_base)
+    {
+#if defined(Q_OS_UNIX)
+        munmap(_native_base, _native_size);
+#elif defined(Q_OS_WIN)
+        UnmapViewOfFile(_native_base);
+#endif
+
+        _native_base = nullptr;
+        _address = nullptr;
+
+        return;
+    }
+
+    uchar *address = invalidate();
+
+    if (address && _device)
+        _device->unmap(address);
+}
+
+
+// Forget a mapping made by the device and return its address if it hadn't
+// already been removed.
+uchar *PyQtFileMapping::invalidate()
+{
+    if (_about_to_close)
+        QObject::disconnect(_about_to_close);
+
+    QMutexLocker locker(&device_mappings_mutex);
+
+    uchar *address = _address;
+
+    if (address)
+    {
+        device_mappings.remove(_device_key, this);
+        _address = nullptr;
+    }
+
+    return address;
+}
+
+
+// Forget all the mappings made by a device that is about to be closed.
+void PyQtFileMapping::deviceClosing(QFileDevice *device)
+{
+    QMutexLocker locker(&device_mappings_mutex);
+
+    const auto mappings = device_mappings.values(device);
+
+    for (PyQtFileMapping *mapping : mappings)
+        mapping->_address = nullptr;
+
+    device_mappings.remove(device);
+}
@@ -0,0 +1,91 @@
+// This is the declaration of the PyQtFileMapping class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_PYQTFILEMAPPING_H
+#define _QPYCORE_PYQTFILEMAPPING_H
+
+
+#include <Python.h>
+
+#include <QFileDevice>
+#include <QMetaObject>
+#include <QPointer>
+
+
+// This class implements a memory mapping of part of a file that exports the
+// buffer protocol.  Where the device has a native file handle the mapping is
+// made directly so that it remains valid however the device is closed.
+// Otherwise the mapping is made by the device and cannot be removed, either
+// explicitly or by closing the file from Python, while there are exported
+// views of it.
+class PyQtFileMapping
+{
+public:
+    // The hints that can be given about how the mapping will be accessed.
+    enum Advice {
+        NormalAccess,
+        SequentialAccess,
+        RandomAccess,
+        WillNeed,
+        DontNeed
+    };
+
+    PyQtFileMapping(QFileDevice *device, PyObject *device_wrapper,
+            qint64 offset, qint64 size, QFileDevice::MemoryMapFlags flags);
+    ~PyQtFileMapping();
+
+    bool isValid() const {return _address;}
+    qint64 size() const {return _address ? _size : 0;}
+    bool isWritable() const {return _writable;}
+    int exportCount() const {return _exports;}
+
+    bool unmap();
+    bool advise(Advice advice, qint64 offset, qint64 length);
+
+    int getBuffer(void **buf, Py_ssize_t *len, int *readonly);
+    void releaseBuffer();
+
+    static bool canClose(QFileDevice *device);
+
+private:
+    QPointer<QFileDevice> _device;
+    QFileDevice *_device_key;
+    PyObject *_device_wrapper;
+    uchar *_address;
+    qint64 _size;
+    bool _writable;
+    int _exports;
+    void *_native_base;
+    size_t _native_size;
+    QMetaObject::Connection _about_to_close;
+
+    bool mapNative(int fd, qint64 offset, QIODevice::OpenMode mode,
+            QFileDevice::MemoryMapFlags flags);
+    void unmapAddress();
+    uchar *invalidate();
+
+    static void deviceClosing(QFileDevice *device);
+
+    PyQtFileMapping(const PyQtFileMapping &);
+};
+
+
+#endif
@@ -0,0 +1,453 @@
+// This is the implementation of the PyQtGILTrace class and its public API.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <Python.h>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QThread>
+
+#include "qpycore_clock.h"
+#include "qpycore_public_api.h"
+#include "qpycore_pyqtgiltrace.h"
+
+
+// The statistics of a call site.  Sites are never destroyed.
+struct GILSite
+{
+    GILSite(const char *site_name) : name(site_name), next(0)
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        count.store(0, std::memory_order_relaxed);
+        wait_total.store(0, std::memory_order_relaxed);
+        wait_max.store(0, std::memory_order_relaxed);
+        hold_total.store(0, std::memory_order_relaxed);
+        hold_max.store(0, std::memory_order_relaxed);
+
+        for (int i = 0; i < QPYCORE_NR_BUCKETS; ++i)
+        {
+            wait_histogram[i].store(0, std::memory_order_relaxed);
+            hold_histogram[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    const char *name;
+    std::atomic<qint64> count;
+    std::atomic<qint64> wait_total;
+    std::atomic<qint64> wait_max;
+    std::atomic<qint64> hold_total;
+    std::atomic<qint64> hold_max;
+    std::atomic<qint64> wait_histogram[QPYCORE_NR_BUCKETS];
+    std::atomic<qint64> hold_histogram[QPYCORE_NR_BUCKETS];
+    GILSite *next;
+};
+
+
+// An acquisition in the ring buffer.  The sequence number is odd while the
+// slot is being written and is 0 if the slot has never been written.
+struct GILSlot
+{
+    std::atomic<quint64> seq;
+    std::atomic<GILSite *> site;
+    std::atomic<quintptr> thread;
+    std::atomic<qint64> begin;
+    std::atomic<qint64> acquired;
+    std::atomic<qint64> released;
+};
+
+
+// The ring buffer.  A buffer that has been replaced is only freed when no
+// thread can still be writing to it.
+struct GILRing
+{
+    GILRing(quint64 nr_slots) : capacity(nr_slots), slots(new GILSlot[nr_slots])
+    {
+        clear();
+    }
+
+    ~GILRing()
+    {
+        delete[] slots;
+    }
+
+    void clear()
+    {
+        for (quint64 i = 0; i < capacity; ++i)
+            slots[i].seq.store(0, std::memory_order_relaxed);
+    }
+
+    const quint64 capacity;
+    GILSlot *slots;
+};
+
+
+// The static members of PyQtGILTrace.
+std::atomic<bool> PyQtGILTrace::enabled(false);
+
+
+// The registered call sites.
+static QMutex sites_mutex;
+static GILSite *sites = 0;
+
+// The current ring buffer, the number of acquisitions recorded in it and the
+// number of threads that may be writing to it.
+static std::atomic<GILRing *> ring(nullptr);
+static std::atomic<quint64> ring_head(0);
+static std::atomic<int> ring_writers(0);
+
+
+// Forward declarations.
+static void update_max(std::atomic<qint64> &max, qint64 value);
+
+
+// Enable or disable the recording of acquisitions.
+void PyQtGILTrace::setEnabled(bool enable)
+{
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+
+// Return the capacity of the ring buffer.
+int PyQtGILTrace::capacity()
+{
+    GILRing *r = ring.load(std::memory_order_acquire);
+
+    return (r ? int(r->capacity) : 0);
+}
+
+
+// Set the capacity of the ring buffer.  0 means that individual acquisitions
+// are not recorded.  Any existing contents are discarded.
+void PyQtGILTrace::setCapacity(int capacity)
+{
+    if (capacity < 0)
+        capacity = 0;
+
+    if (capacity == PyQtGILTrace::capacity())
+    {
+        clearRing();
+        return;
+    }
+
+    GILRing *r = (capacity > 0 ? new GILRing(quint64(capacity)) : nullptr);
+
+    GILRing *old = ring.exchange(r);
+    ring_head.store(0, std::memory_order_relaxed);
+
+    if (old)
+    {
+        // Wait for any writers that may have loaded the old ring.  They only
+        // hold it for a few stores.
+        while (ring_writers.load() != 0)
+            QThread::yieldCurrentThread();
+
+        delete old;
+    }
+}
+
+
+// Discard all statistics and the contents of the ring buffer.
+void PyQtGILTrace::reset()
+{
+    sites_mutex.lock();
+
+    for (GILSite *s = sites; s; s = s->next)
+        s->clear();
+
+    sites_mutex.unlock();
+
+    clearRing();
+}
+
+
+// Discard the contents of the ring buffer.  Any acquisition being written at
+// the same time has a sequence number that no longer matches its slot and is
+// ignored.
+void PyQtGILTrace::clearRing()
+{
+    GILRing *r = ring.load(std::memory_order_acquire);
+
+    if (r)
+        r->clear();
+
+    ring_head.store(0, std::memory_order_release);
+}
+
+
+// Return the statistics of each call site that has been recorded.
+PyObject *PyQtGILTrace::histograms()
+{
+    PyObject *res = PyList_New(0);
+
+    if (!res)
+        return 0;
+
+    QMutexLocker locker(&sites_mutex);
+
+    for (GILSite *s = sites; s; s = s->next)
+    {
+        qint64 count = s->count.load(std::memory_order_relaxed);
+
+        if (count == 0)
+            continue;
+
+        PyObject *wait_hist = PyList_New(QPYCORE_NR_BUCKETS);
+        PyObject *hold_hist = PyList_New(QPYCORE_NR_BUCKETS);
+        PyObject *entry = 0;
+
+        if (wait_hist && hold_hist)
+        {
+            bool ok = true;
+
+            for (int i = 0; i < QPYCORE_NR_BUCKETS; ++i)
+            {
+                PyObject *w = PyLong_FromLongLong(
+                        s->wait_histogram[i].load(std::memory_order_relaxed));
+                PyObject *h = PyLong_FromLongLong(
+                        s->hold_histogram[i].load(std::memory_order_relaxed));
+
+                if (w)
+                    PyList_SetItem(wait_hist, i, w);
+
+                if (h)
+                    PyList_SetItem(hold_hist, i, h);
+
+                if (!w || !h)
+                {
+                    ok = false;
+                    break;
+                }
+            }
+
+            if (ok)
+                entry = Py_BuildValue("(sLddddOO)", s->name, (long long)count,
+                        s->wait_total.load(std::memory_order_relaxed) / 1.0e9,
+                        s->wait_max.load(std::memory_order_relaxed) / 1.0e9,
+                        s->hold_total.load(std::memory_order_relaxed) / 1.0e9,
+                        s->hold_max.load(std::memory_order_relaxed) / 1.0e9,
+                        wait_hist, hold_hist);
+        }
+
+        Py_XDECREF(wait_hist);
+        Py_XDECREF(hold_hist);
+
+        if (!entry || PyList_Append(res, entry) < 0)
+        {
+            Py_XDECREF(entry);
+            Py_DECREF(res);
+            return 0;
+        }
+
+        Py_DECREF(entry);
+    }
+
+    return res;
+}
+
+
+// Return the contents of the ring buffer in the Chrome trace event format that
+// is also understood by Perfetto.  Each acquisition is a complete event while
+// the GIL was held preceded by one while waiting for it.
+QByteArray PyQtGILTrace::traceJson()
+{
+    QJsonArray events;
+    GILRing *r = ring.load(std::memory_order_acquire);
+
+    if (r)
+    {
+        quint64 head = ring_head.load(std::memory_order_acquire);
+        quint64 first = (head > r->capacity ? head - r->capacity : 0);
+
+        for (quint64 n = first; n < head; ++n)
+        {
+            GILSlot &slot = r->slots[n % r->capacity];
+
+            quint64 seq = slot.seq.load(std::memory_order_acquire);
+
+            // Skip the slot if it is being written or has been overwritten.
+            if (seq != 2 * n + 2)
+                continue;
+
+            GILSite *s = slot.site.load(std::memory_order_relaxed);
+            qint64 tid = qint64(slot.thread.load(std::memory_order_relaxed));
+            qint64 begin = slot.begin.load(std::memory_order_relaxed);
+            qint64 acquired = slot.acquired.load(std::memory_order_relaxed);
+            qint64 released = slot.released.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (slot.seq.load(std::memory_order_relaxed) != seq)
+                continue;
+
+            QString name = QString::fromLatin1(s->name);
+
+            QJsonObject wait;
+
+            wait.insert("name", QString("GIL wait: ") + name);
+            wait.insert("cat", "gil");
+            wait.insert("ph", "X");
+            wait.insert("ts", begin / 1.0e3);
+            wait.insert("dur", (acquired - begin) / 1.0e3);
+            wait.insert("pid", 0);
+            wait.insert("tid", tid);
+
+            events.append(wait);
+
+            QJsonObject hold;
+
+            hold.insert("name", name);
+            hold.insert("cat", "gil");
+            hold.insert("ph", "X");
+            hold.insert("ts", acquired / 1.0e3);
+            hold.insert("dur", (released - acquired) / 1.0e3);
+            hold.insert("pid", 0);
+            hold.insert("tid", tid);
+
+            events.append(hold);
+        }
+    }
+
+    QJsonObject root;
+
+    root.insert("traceEvents", events);
+    root.insert("displayTimeUnit", "ms");
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+
+// Return the site with a name, registering it if necessary.  The name must be
+// a string literal.  This doesn't need the GIL.
+void *PyQtGILTrace::site(const char *name)
+{
+    QMutexLocker locker(&sites_mutex);
+
+    for (GILSite *s = sites; s; s = s->next)
+        if (qstrcmp(s->name, name) == 0)
+            return s;
+
+    GILSite *s = new GILSite(name);
+
+    s->next = sites;
+    sites = s;
+
+    return s;
+}
+
+
+// Record an acquisition of the GIL at a site.  This doesn't need the GIL and
+// doesn't block.
+void PyQtGILTrace::record(void *site_v, qint64 begin, qint64 acquired,
+        qint64 released)
+{
+    GILSite *s = reinterpret_cast<GILSite *>(site_v);
+    qint64 wait = acquired - begin;
+    qint64 hold = released - acquired;
+
+    s->count.fetch_add(1, std::memory_order_relaxed);
+    s->wait_total.fetch_add(wait, std::memory_order_relaxed);
+    s->hold_total.fetch_add(hold, std::memory_order_relaxed);
+    s->wait_histogram[qpycore_bucket(wait)].fetch_add(1,
+            std::memory_order_relaxed);
+    s->hold_histogram[qpycore_bucket(hold)].fetch_add(1,
+            std::memory_order_relaxed);
+    update_max(s->wait_max, wait);
+    update_max(s->hold_max, hold);
+
+    // This must be ordered before the ring is loaded so that the ring can't be
+    // freed while it is being written.
+    ring_writers.fetch_add(1);
+
+    GILRing *r = ring.load();
+
+    if (!r)
+    {
+        ring_writers.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    quint64 n = ring_head.fetch_add(1, std::memory_order_relaxed);
+    GILSlot &slot = r->slots[n % r->capacity];
+
+    slot.seq.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.site.store(s, std::memory_order_relaxed);
+    slot.thread.store(quintptr(QThread::currentThreadId()),
+            std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.acquired.store(acquired, std::memory_order_relaxed);
+    slot.released.store(released, std::memory_order_relaxed);
+
+    slot.seq.store(2 * n + 2, std::memory_order_release);
+
+    ring_writers.fetch_sub(1, std::memory_order_release);
+}
+
+
+// Update a maximum value.
+static void update_max(std::atomic<qint64> &max, qint64 value)
+{
+    qint64 current = max.load(std::memory_order_relaxed);
+
+    while (value > current)
+        if (max.compare_exchange_weak(current, value,
+                std::memory_order_relaxed))
+            break;
+}
+
+
+// Return the time that the GIL is about to be acquired at a site or 0 if
+// acquisitions are not being recorded.  This is part of the public API.
+qint64 pyqt6_gil_trace_begin()
+{
+    return (PyQtGILTrace::isEnabled() ? qpycore_now() : 0);
+}
+
+
+// Return the current time.  This is part of the public API.
+qint64 pyqt6_gil_trace_now()
+{
+    return qpycore_now();
+}
+
+
+// Return the handle of a site.  This is part of the public API.
+void *pyqt6_gil_trace_site(const char *name)
+{
+    return PyQtGILTrace::site(name);
+}
+
+
+// Record an acquisition of the GIL that is about to be released.  This is part
+// of the public API.
+void pyqt6_gil_trace_end(void *site, qint64 begin, qint64 acquired)
+{
+    PyQtGILTrace::record(site, begin, acquired, qpycore_now());
+}
@@ -0,0 +1,68 @@
+// This is the declaration of the PyQtGILTrace class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_PYQTGILTRACE_H
+#define _QPYCORE_PYQTGILTRACE_H
+
+
+#include <Python.h>
+
+#include <atomic>
+
+#include <QByteArray>
+
+
+// This class records the acquisitions of the GIL made by C++ code called from
+// Qt.  Each call site has histograms of the time spent waiting for the GIL and
+// the time it was held.  Individual acquisitions are recorded in a lock-free
+// ring buffer.  Recording doesn't need the GIL.  The other static methods must
+// be called with the GIL held.
+class PyQtGILTrace
+{
+public:
+    static bool isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enable);
+
+    static int capacity();
+    static void setCapacity(int capacity);
+
+    static void reset();
+    static PyObject *histograms();
+    static QByteArray traceJson();
+
+    static void *site(const char *name);
+    static void record(void *site, qint64 begin, qint64 acquired,
+            qint64 released);
+
+private:
+    static std::atomic<bool> enabled;
+
+    static void clearRing();
+
+    PyQtGILTrace();
+};
+
+
+#endif
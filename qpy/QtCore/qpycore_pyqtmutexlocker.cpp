@@ -20,38 +20,74 @@
 
 #include <Python.h>
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMutex>
 
 #include "qpycore_pyqtmutexlocker.h"
 
 
-// Create a locker for a QMutex.
+// The contention statistics of a mutex.
+struct MutexStatistics
+{
+    MutexStatistics() : acquisitions(0), contended(0), total_wait(0),
+            max_wait(0), wrapper_ref(0) {}
+
+    // The number of times the mutex has been acquired.
+    quint64 acquisitions;
+
+    // The number of times the mutex had to be waited for.
+    quint64 contended;
+
+    // The total and maximum wait times in nanoseconds.
+    qint64 total_wait;
+    qint64 max_wait;
+
+    // A weak reference to the Python object that wraps the mutex.
+    PyObject *wrapper_ref;
+};
+
+
+// The statistics keyed by the address of the mutex.  These are only updated
+// with the GIL held.  An entry is removed when the Python object that wraps
+// the mutex is garbage collected so that a mutex later created at the same
+// address doesn't inherit the statistics.
+static QHash<const void *, MutexStatistics> mutex_statistics;
+
+
+// Forward declarations.
+static MutexStatistics *statistics_of(const void *addr, PyObject *wrapper);
+static PyObject *wrapper_collected(PyObject *addr_obj, PyObject *ref);
+
+
+// Set if contention statistics are being collected.
+bool PyQtMutexLocker::statistics_enabled = false;
+
+
+// Create a locker for a QMutex.  This is called with the GIL.
 PyQtMutexLocker::PyQtMutexLocker(QMutex *mutex, PyObject *wrapper) :
-        _wrapper(wrapper), _r_locker(nullptr)
+        _wrapper(wrapper), _mutex(mutex), _r_mutex(nullptr), _locked(false)
 {
     Py_INCREF(_wrapper);
 
-    _locker = new QMutexLocker<QMutex>(mutex);
+    lock();
 }
 
 
-// Create a locker for a QRecursiveMutex.
+// Create a locker for a QRecursiveMutex.  This is called with the GIL.
 PyQtMutexLocker::PyQtMutexLocker(QRecursiveMutex *mutex, PyObject *wrapper) :
-        _wrapper(wrapper), _locker(nullptr)
+        _wrapper(wrapper), _mutex(nullptr), _r_mutex(mutex), _locked(false)
 {
     Py_INCREF(_wrapper);
 
-    _r_locker = new QMutexLocker<QRecursiveMutex>(mutex);
+    lock();
 }
 
 
 // Destroy the locker.
 PyQtMutexLocker::~PyQtMutexLocker()
 {
-    if (_locker)
-        delete _locker;
-    else
-        delete _r_locker;
+    unlock();
 
     Py_DECREF(_wrapper);
 }
@@ -69,18 +105,183 @@ PyObject *PyQtMutexLocker::mutex()
 // Explicitly unlock the mutex.
 void PyQtMutexLocker::unlock()
 {
-    if (_locker)
-        _locker->unlock();
+    if (!_locked)
+        return;
+
+    if (_mutex)
+        _mutex->unlock();
     else
-        _r_locker->unlock();
+        _r_mutex->unlock();
+
+    _locked = false;
 }
 
 
-// Explicitly relock the mutex.
+// Explicitly relock the mutex.  This is called with the GIL.
 void PyQtMutexLocker::relock()
 {
-    if (_locker)
-        _locker->relock();
+    if (!_locked)
+        lock();
+}
+
+
+// Lock the mutex.  This is called with the GIL which is only released if the
+// mutex is already locked by another thread.  A thread holding the mutex may
+// be waiting for the GIL, so holding it while blocking risks a deadlock.
+void PyQtMutexLocker::lock()
+{
+    // Like QMutexLocker, a locker for a null mutex does nothing.
+    if (!_mutex && !_r_mutex)
+        return;
+
+    const void *addr = (_mutex ? static_cast<const void *>(_mutex) :
+            static_cast<const void *>(_r_mutex));
+
+    if (tryLock())
+    {
+        if (statistics_enabled)
+        {
+            MutexStatistics *stats = statistics_of(addr, _wrapper);
+
+            if (stats)
+                ++stats->acquisitions;
+        }
+    }
     else
-        _r_locker->relock();
+    {
+        QElapsedTimer timer;
+
+        if (statistics_enabled)
+            timer.start();
+
+        Py_BEGIN_ALLOW_THREADS
+
+        if (_mutex)
+            _mutex->lock();
+        else
+            _r_mutex->lock();
+
+        Py_END_ALLOW_THREADS
+
+        if (statistics_enabled && timer.isValid())
+        {
+            qint64 wait = timer.nsecsElapsed();
+            MutexStatistics *stats = statistics_of(addr, _wrapper);
+
+            if (stats)
+            {
+                ++stats->acquisitions;
+                ++stats->contended;
+                stats->total_wait += wait;
+
+                if (stats->max_wait < wait)
+                    stats->max_wait = wait;
+            }
+        }
+    }
+
+    _locked = true;
+}
+
+
+// Try and lock the mutex without blocking.  The mutex must not be null.
+bool PyQtMutexLocker::tryLock()
+{
+    if (_mutex)
+        return _mutex->tryLock();
+
+    return _r_mutex->tryLock();
+}
+
+
+// Return a tuple of the contention statistics of a mutex, ie. the number of
+// acquisitions, the number of those that had to wait, and the total and
+// maximum wait times in seconds.  This is called with the GIL.
+PyObject *PyQtMutexLocker::statistics(const void *mutex)
+{
+    MutexStatistics stats = mutex_statistics.value(mutex);
+
+    return Py_BuildValue("(KKdd)", (unsigned long long)stats.acquisitions,
+            (unsigned long long)stats.contended, stats.total_wait / 1.0e9,
+            stats.max_wait / 1.0e9);
+}
+
+
+// Discard all contention statistics.  This is called with the GIL.
+void PyQtMutexLocker::resetStatistics()
+{
+    for (const MutexStatistics &stats : mutex_statistics)
+        Py_XDECREF(stats.wrapper_ref);
+
+    mutex_statistics.clear();
+}
+
+
+// Return the statistics of a mutex, creating them if necessary, or 0 if there
+// was an error.  This is called with the GIL.
+static MutexStatistics *statistics_of(const void *addr, PyObject *wrapper)
+{
+    QHash<const void *, MutexStatistics>::iterator it = mutex_statistics.find(
+            addr);
+
+    if (it != mutex_statistics.end())
+        return &it.value();
+
+    static PyMethodDef collected_md = {
+        "_wrapper_collected", wrapper_collected, METH_O, NULL
+    };
+
+    PyObject *addr_obj = PyLong_FromVoidPtr(const_cast<void *>(addr));
+
+    if (!addr_obj)
+    {
+        PyErr_Clear();
+        return 0;
+    }
+
+    PyObject *callback = PyCFunction_New(&collected_md, addr_obj);
+
+    Py_DECREF(addr_obj);
+
+    if (!callback)
+    {
+        PyErr_Clear();
+        return 0;
+    }
+
+    PyObject *ref = PyWeakref_NewRef(wrapper, callback);
+
+    Py_DECREF(callback);
+
+    if (!ref)
+    {
+        PyErr_Clear();
+        return 0;
+    }
+
+    MutexStatistics &stats = mutex_statistics[addr];
+
+    stats.wrapper_ref = ref;
+
+    return &stats;
+}
+
+
+// Invoked when the Python object that wraps a mutex with statistics is garbage
+// collected.
+static PyObject *wrapper_collected(PyObject *addr_obj, PyObject *ref)
+{
+    QHash<const void *, MutexStatistics>::iterator it = mutex_statistics.find(
+            PyLong_AsVoidPtr(addr_obj));
+
+    // Make sure the statistics haven't been reset since the reference was
+    // created.
+    if (it != mutex_statistics.end() && it.value().wrapper_ref == ref)
+    {
+        mutex_statistics.erase(it);
+        Py_DECREF(ref);
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
 }
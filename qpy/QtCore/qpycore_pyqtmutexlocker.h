@@ -23,8 +23,9 @@
 #include <QMutex>
 
 
-// This class implements the Qt5 QMutexLocker on top of the Qt6 template-based
-// version.
+// This class implements the Qt5 QMutexLocker.  Unlike the Qt6 template-based
+// version a mutex that is already locked by another thread is waited for
+// without the GIL.
 class PyQtMutexLocker
 {
 public:
@@ -36,10 +37,20 @@ public:
     void unlock();
     void relock();
 
+    static PyObject *statistics(const void *mutex);
+    static void resetStatistics();
+
+    // Set if contention statistics are being collected.
+    static bool statistics_enabled;
+
 private:
     PyObject *_wrapper;
-    QMutexLocker<QMutex> *_locker;
-    QMutexLocker<QRecursiveMutex> *_r_locker;
+    QMutex *_mutex;
+    QRecursiveMutex *_r_mutex;
+    bool _locked;
+
+    void lock();
+    bool tryLock();
 
     PyQtMutexLocker(const PyQtMutexLocker &);
 };
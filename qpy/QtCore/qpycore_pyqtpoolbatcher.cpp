@@ -0,0 +1,391 @@
+// This is the implementation of the PyQtPoolBatcher class and its API.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <Python.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QThreadPool>
+
+#include "qpycore_api.h"
+#include "qpycore_pyqtpoolbatcher.h"
+
+#include "sipAPIQtCore.h"
+
+
+// The batcher of each pool.  A batcher may be destroyed without the GIL so
+// access is protected by a mutex.
+static QHash<QThreadPool *, PyQtPoolBatcher *> pool_batchers;
+static QMutex pool_batchers_mutex;
+
+
+// Create the batcher for a pool.  A QObject cannot be given a parent in
+// another thread so, if the pool isn't in the current thread, the batcher is
+// moved to the pool's thread and the parent is set from there.
+PyQtPoolBatcher::PyQtPoolBatcher(QThreadPool *pool) : QObject(),
+        _pool(pool), _pool_key(pool), _completed(nullptr)
+{
+    if (pool->thread() == QThread::currentThread())
+    {
+        setParent(pool);
+    }
+    else
+    {
+        moveToThread(pool->thread());
+
+        QMetaObject::invokeMethod(this, [this]() {
+            if (_pool)
+                setParent(_pool);
+            else
+                delete this;
+        }, Qt::QueuedConnection);
+    }
+
+    QMutexLocker locker(&pool_batchers_mutex);
+
+    pool_batchers.insert(pool, this);
+}
+
+
+// Destroy the batcher.  The pool will have waited for any outstanding batches
+// to complete.
+PyQtPoolBatcher::~PyQtPoolBatcher()
+{
+    pool_batchers_mutex.lock();
+
+    // The pool may have been replaced by another at the same address.
+    if (pool_batchers.value(_pool_key) == this)
+        pool_batchers.remove(_pool_key);
+
+    pool_batchers_mutex.unlock();
+
+    PyQtPoolFutureState *state = _completed.exchange(nullptr);
+
+    if (state && sipGetInterpreter())
+    {
+        QPYCORE_BLOCK_THREADS("PyQtPoolBatcher::~PyQtPoolBatcher()")
+
+        while (state)
+        {
+            PyQtPoolFutureState *next = state->next;
+
+            state->deref();
+            state = next;
+        }
+
+        QPYCORE_UNBLOCK_THREADS
+    }
+}
+
+
+// Return the existing batcher of a pool.
+PyQtPoolBatcher *PyQtPoolBatcher::find(QThreadPool *pool)
+{
+    QMutexLocker locker(&pool_batchers_mutex);
+
+    PyQtPoolBatcher *batcher = pool_batchers.value(pool);
+
+    // Ignore a batcher whose pool was destroyed before it became its parent.
+    if (batcher && batcher->_pool != pool)
+        batcher = nullptr;
+
+    return batcher;
+}
+
+
+// Return the batcher of a pool, creating it if necessary.
+PyQtPoolBatcher *PyQtPoolBatcher::findOrCreate(QThreadPool *pool)
+{
+    PyQtPoolBatcher *batcher = find(pool);
+
+    if (!batcher)
+        batcher = new PyQtPoolBatcher(pool);
+
+    return batcher;
+}
+
+
+// Submit an iterable of callables in batches and return a list of their
+// futures.  The GIL must be held.
+PyObject *PyQtPoolBatcher::submit(PyObject *callables, int batch_size,
+        int priority)
+{
+    PyObject *iter = PyObject_GetIter(callables);
+
+    if (!iter)
+        return 0;
+
+    PyObject *futures = PyList_New(0);
+
+    if (!futures)
+    {
+        Py_DECREF(iter);
+        return 0;
+    }
+
+    QList<PyQtPoolFutureState *> states;
+    PyObject *callable;
+
+    while ((callable = PyIter_Next(iter)) != NULL)
+    {
+        if (!PyCallable_Check(callable))
+        {
+            PyErr_Format(PyExc_TypeError,
+                    "callables must contain callable objects, not '%s'",
+                    sipPyTypeName(Py_TYPE(callable)));
+            Py_DECREF(callable);
+            break;
+        }
+
+        PyQtPoolFutureState *state = new PyQtPoolFutureState(callable);
+
+        Py_DECREF(callable);
+
+        // The batch holds a reference until the state has been delivered.
+        state->ref();
+        states.append(state);
+
+        PyQtPoolFuture *future_cpp = new PyQtPoolFuture(state);
+        PyObject *future = sipConvertFromNewType(future_cpp,
+                sipType_PyQtPoolFuture, NULL);
+
+        if (!future)
+        {
+            delete future_cpp;
+            break;
+        }
+
+        int rc = PyList_Append(futures, future);
+
+        Py_DECREF(future);
+
+        if (rc < 0)
+            break;
+    }
+
+    Py_DECREF(iter);
+
+    if (PyErr_Occurred())
+    {
+        Py_DECREF(futures);
+
+        for (PyQtPoolFutureState *state : states)
+            state->deref();
+
+        return 0;
+    }
+
+    qsizetype nr_calls = states.size();
+
+    if (nr_calls == 0)
+        return futures;
+
+    // By default spread the calls evenly across the threads.
+    if (batch_size <= 0)
+    {
+        int nr_threads = qMax(_pool->maxThreadCount(), 1);
+
+        batch_size = int((nr_calls + nr_threads - 1) / nr_threads);
+    }
+
+    qsizetype nr_batches = (nr_calls + batch_size - 1) / batch_size;
+
+    _queued_batches.fetchAndAddRelaxed(nr_batches);
+    _queued_calls.fetchAndAddRelaxed(nr_calls);
+
+    Py_BEGIN_ALLOW_THREADS
+
+    for (qsizetype start = 0; start < nr_calls; start += batch_size)
+    {
+        QList<PyQtPoolFutureState *> batch = states.mid(start, batch_size);
+
+        _pool->start([this, batch]() {
+            run(batch);
+        }, priority);
+    }
+
+    Py_END_ALLOW_THREADS
+
+    return futures;
+}
+
+
+// Return the statistics of the batcher.
+PyObject *PyQtPoolBatcher::statistics() const
+{
+    return Py_BuildValue("(LLLLdd)", (long long)_queued_batches.loadRelaxed(),
+            (long long)_queued_calls.loadRelaxed(),
+            (long long)_batches.loadRelaxed(),
+            (long long)_calls.loadRelaxed(), _gil_wait.loadRelaxed() / 1.0e9,
+            _max_gil_wait.loadRelaxed() / 1.0e9);
+}
+
+
+// Run a batch of callables in a thread of the pool.
+void PyQtPoolBatcher::run(const QList<PyQtPoolFutureState *> &batch)
+{
+    _queued_batches.fetchAndSubRelaxed(1);
+    _queued_calls.fetchAndSubRelaxed(batch.size());
+
+    // The wait is used after the GIL has been released so it is declared
+    // outside the scope of the GIL block.
+    QElapsedTimer wait_timer;
+    qint64 wait;
+
+    wait_timer.start();
+
+    QPYCORE_BLOCK_THREADS("PyQtPoolBatcher::run()")
+
+    wait = wait_timer.nsecsElapsed();
+
+    for (PyQtPoolFutureState *state : batch)
+    {
+        PyObject *res = PyObject_CallObject(state->callable, NULL);
+
+        if (res)
+        {
+            state->result = res;
+        }
+        else
+        {
+            PyObject *exception, *value, *traceback;
+
+            PyErr_Fetch(&exception, &value, &traceback);
+            PyErr_NormalizeException(&exception, &value, &traceback);
+
+            if (traceback)
+            {
+                PyException_SetTraceback(value, traceback);
+                Py_DECREF(traceback);
+            }
+
+            Py_XDECREF(exception);
+
+            state->exception = value;
+        }
+
+        Py_CLEAR(state->callable);
+        state->finished.storeRelease(1);
+    }
+
+    QPYCORE_UNBLOCK_THREADS
+
+    // Update the statistics and publish the results without the GIL.
+    _gil_wait.fetchAndAddRelaxed(wait);
+
+    qint64 max_wait = _max_gil_wait.loadRelaxed();
+
+    while (wait > max_wait)
+        if (_max_gil_wait.testAndSetRelaxed(max_wait, wait, max_wait))
+            break;
+
+    _batches.fetchAndAddRelaxed(1);
+    _calls.fetchAndAddRelaxed(batch.size());
+
+    // Like the rest of the stack, the batch is linked from the most recently
+    // completed.
+    for (qsizetype i = batch.size() - 1; i > 0; --i)
+        batch.at(i)->next = batch.at(i - 1);
+
+    complete(batch.last(), batch.first());
+}
+
+
+// Push a chain of completed callables, linked from the most recently
+// completed, onto the stack and arrange for them to be delivered.
+void PyQtPoolBatcher::complete(PyQtPoolFutureState *first,
+        PyQtPoolFutureState *last)
+{
+    PyQtPoolFutureState *head = _completed.load(std::memory_order_relaxed);
+
+    do
+        last->next = head;
+    while (!_completed.compare_exchange_weak(head, first,
+            std::memory_order_release, std::memory_order_relaxed));
+
+    // Only the push onto an empty stack needs to schedule a delivery.
+    if (!head)
+        QMetaObject::invokeMethod(this, [this]() {
+            deliver();
+        }, Qt::QueuedConnection);
+}
+
+
+// Deliver all the completed callables in the thread of the pool.
+void PyQtPoolBatcher::deliver()
+{
+    PyQtPoolFutureState *state = _completed.exchange(nullptr,
+            std::memory_order_acquire);
+
+    if (!state || !sipGetInterpreter())
+        return;
+
+    // The stack is in reverse order of completion.
+    PyQtPoolFutureState *ordered = nullptr;
+
+    while (state)
+    {
+        PyQtPoolFutureState *next = state->next;
+
+        state->next = ordered;
+        ordered = state;
+        state = next;
+    }
+
+    QPYCORE_BLOCK_THREADS("PyQtPoolBatcher::deliver()")
+
+    while (ordered)
+    {
+        PyQtPoolFutureState *next = ordered->next;
+
+        PyQtPoolFuture::deliver(ordered);
+        ordered->deref();
+
+        ordered = next;
+    }
+
+    QPYCORE_UNBLOCK_THREADS
+}
+
+
+// Submit an iterable of callables to a pool in batches.
+PyObject *qpycore_qthreadpool_submit_many(QThreadPool *pool,
+        PyObject *callables, int batch_size, int priority)
+{
+    return PyQtPoolBatcher::findOrCreate(pool)->submit(callables, batch_size,
+            priority);
+}
+
+
+// Return the batch statistics of a pool.
+PyObject *qpycore_qthreadpool_batch_statistics(QThreadPool *pool)
+{
+    PyQtPoolBatcher *batcher = PyQtPoolBatcher::find(pool);
+
+    if (!batcher)
+        return Py_BuildValue("(LLLLdd)", 0LL, 0LL, 0LL, 0LL, 0.0, 0.0);
+
+    return batcher->statistics();
+}
@@ -0,0 +1,80 @@
+// This is the declaration of the PyQtPoolBatcher class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_PYQTPOOLBATCHER_H
+#define _QPYCORE_PYQTPOOLBATCHER_H
+
+
+#include <Python.h>
+
+#include <atomic>
+
+#include <QAtomicInteger>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+
+#include "qpycore_pyqtpoolfuture.h"
+
+
+class QThreadPool;
+
+
+// This class submits Python callables to a thread pool in batches that are
+// each run with a single acquisition of the GIL.  Completed callables are
+// pushed onto a lock-free stack and their futures are delivered in the thread
+// of the pool.  It lives in the thread of the pool and is a child of it.
+class PyQtPoolBatcher : public QObject
+{
+public:
+    PyQtPoolBatcher(QThreadPool *pool);
+    ~PyQtPoolBatcher();
+
+    static PyQtPoolBatcher *find(QThreadPool *pool);
+    static PyQtPoolBatcher *findOrCreate(QThreadPool *pool);
+
+    PyObject *submit(PyObject *callables, int batch_size, int priority);
+    PyObject *statistics() const;
+
+private:
+    QPointer<QThreadPool> _pool;
+    QThreadPool *_pool_key;
+
+    // The stack of completed callables.
+    std::atomic<PyQtPoolFutureState *> _completed;
+
+    // The statistics.
+    QAtomicInteger<qint64> _queued_batches;
+    QAtomicInteger<qint64> _queued_calls;
+    QAtomicInteger<qint64> _batches;
+    QAtomicInteger<qint64> _calls;
+    QAtomicInteger<qint64> _gil_wait;
+    QAtomicInteger<qint64> _max_gil_wait;
+
+    void run(const QList<PyQtPoolFutureState *> &batch);
+    void complete(PyQtPoolFutureState *first, PyQtPoolFutureState *last);
+    void deliver();
+
+    PyQtPoolBatcher(const PyQtPoolBatcher &);
+};
+
+
+#endif
@@ -0,0 +1,197 @@
+// This is the implementation of the PyQtPoolFuture class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <Python.h>
+
+#include "qpycore_public_api.h"
+#include "qpycore_pyqtpoolfuture.h"
+
+
+// Create the state of a callable.  The GIL must be held.
+PyQtPoolFutureState::PyQtPoolFutureState(PyObject *callable_obj)
+        : callable(callable_obj), result(0), exception(0), callbacks(0),
+        delivered(false), next(0)
+{
+    Py_INCREF(callable);
+}
+
+
+// Destroy the state.  The GIL must be held.
+PyQtPoolFutureState::~PyQtPoolFutureState()
+{
+    Py_XDECREF(callable);
+    Py_XDECREF(result);
+    Py_XDECREF(exception);
+    Py_XDECREF(callbacks);
+}
+
+
+// Release a reference to the state.  The GIL must be held.
+void PyQtPoolFutureState::deref()
+{
+    if (!_refs.deref())
+        delete this;
+}
+
+
+// Create a future for some state.
+PyQtPoolFuture::PyQtPoolFuture(PyQtPoolFutureState *state) : _state(state)
+{
+    _state->ref();
+}
+
+
+// Create a copy of a future.
+PyQtPoolFuture::PyQtPoolFuture(const PyQtPoolFuture &other)
+        : _state(other._state)
+{
+    _state->ref();
+}
+
+
+// Destroy the future.
+PyQtPoolFuture::~PyQtPoolFuture()
+{
+    _state->deref();
+}
+
+
+// Return true if the callable has been called.
+bool PyQtPoolFuture::done() const
+{
+    return _state->finished.loadAcquire();
+}
+
+
+// Return a new reference to the result of the callable or 0 (with an
+// exception raised) if it raised an exception or hasn't been called.
+PyObject *PyQtPoolFuture::result() const
+{
+    if (!check_done())
+        return 0;
+
+    if (_state->exception)
+    {
+        PyErr_SetObject((PyObject *)Py_TYPE(_state->exception),
+                _state->exception);
+        return 0;
+    }
+
+    Py_INCREF(_state->result);
+    return _state->result;
+}
+
+
+// Return a new reference to the exception raised by the callable, None if
+// there was no exception or 0 (with an exception raised) if it hasn't been
+// called.
+PyObject *PyQtPoolFuture::exception() const
+{
+    if (!check_done())
+        return 0;
+
+    PyObject *exc = (_state->exception ? _state->exception : Py_None);
+
+    Py_INCREF(exc);
+    return exc;
+}
+
+
+// Add a callable to be called with the future when it has been delivered to
+// the thread of the pool.  It is called immediately if it has already been
+// delivered.
+bool PyQtPoolFuture::addDoneCallback(PyObject *callback, PyObject *future)
+{
+    if (_state->delivered)
+    {
+        PyObject *res = PyObject_CallFunctionObjArgs(callback, future, NULL);
+
+        if (!res)
+            return false;
+
+        Py_DECREF(res);
+
+        return true;
+    }
+
+    if (!_state->callbacks)
+    {
+        _state->callbacks = PyList_New(0);
+
+        if (!_state->callbacks)
+            return false;
+    }
+
+    PyObject *entry = PyTuple_Pack(2, callback, future);
+
+    if (!entry)
+        return false;
+
+    int rc = PyList_Append(_state->callbacks, entry);
+
+    Py_DECREF(entry);
+
+    return (rc == 0);
+}
+
+
+// Deliver a completed future by calling any done callbacks.  The GIL must be
+// held.
+void PyQtPoolFuture::deliver(PyQtPoolFutureState *state)
+{
+    state->delivered = true;
+
+    // Note that this breaks the reference cycle between the state and any
+    // futures passed to addDoneCallback().
+    PyObject *callbacks = state->callbacks;
+    state->callbacks = 0;
+
+    if (!callbacks)
+        return;
+
+    for (Py_ssize_t i = 0; i < PyList_Size(callbacks); ++i)
+    {
+        PyObject *entry = PyList_GetItem(callbacks, i);
+
+        PyObject *res = PyObject_CallFunctionObjArgs(
+                PyTuple_GetItem(entry, 0), PyTuple_GetItem(entry, 1), NULL);
+
+        if (res)
+            Py_DECREF(res);
+        else
+            pyqt6_err_print();
+    }
+
+    Py_DECREF(callbacks);
+}
+
+
+// Check that the future is done and raise an exception if not.
+bool PyQtPoolFuture::check_done() const
+{
+    if (done())
+        return true;
+
+    PyErr_SetString(PyExc_RuntimeError,
+            "the callable submitted to the thread pool has not completed");
+
+    return false;
+}
@@ -0,0 +1,94 @@
+// This is the declaration of the PyQtPoolFuture class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_PYQTPOOLFUTURE_H
+#define _QPYCORE_PYQTPOOLFUTURE_H
+
+
+#include <Python.h>
+
+#include <QAtomicInt>
+
+
+// The state of a Python callable submitted to a thread pool.  It is shared
+// between the futures that refer to it, the batch that runs it and the queue
+// of completed callables.  The last reference must be released with the GIL
+// held.
+struct PyQtPoolFutureState
+{
+    PyQtPoolFutureState(PyObject *callable);
+
+    void ref() {_refs.ref();}
+    void deref();
+
+    // The callable.  It is released once it has been called.
+    PyObject *callable;
+
+    // The result or the exception raised.
+    PyObject *result;
+    PyObject *exception;
+
+    // The list of (callback, future) tuples to call when the future is
+    // delivered.
+    PyObject *callbacks;
+
+    // Set when the result or exception is available.
+    QAtomicInt finished;
+
+    // Set when the future has been delivered to the thread of the pool.
+    bool delivered;
+
+    // The link in the queue of completed callables.
+    PyQtPoolFutureState *next;
+
+private:
+    QAtomicInt _refs;
+
+    ~PyQtPoolFutureState();
+};
+
+
+// This class implements a lightweight future of a Python callable submitted to
+// a thread pool.  The GIL must be held when it is created or destroyed.
+class PyQtPoolFuture
+{
+public:
+    PyQtPoolFuture(PyQtPoolFutureState *state);
+    PyQtPoolFuture(const PyQtPoolFuture &other);
+    ~PyQtPoolFuture();
+
+    bool done() const;
+    PyObject *result() const;
+    PyObject *exception() const;
+    bool addDoneCallback(PyObject *callback, PyObject *future);
+
+    static void deliver(PyQtPoolFutureState *state);
+
+private:
+    PyQtPoolFutureState *_state;
+
+    bool check_done() const;
+
+    PyQtPoolFuture &operator=(const PyQtPoolFuture &);
+};
+
+
+#endif
@@ -0,0 +1,199 @@
+// This is the implementation of the PyQtProcessPump class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <string.h>
+
+#include "qpycore_pyqtprocesspump.h"
+
+
+// Create the pump for a channel of a process.
+PyQtProcessPump::PyQtProcessPump(QProcess *process,
+        QProcess::ProcessChannel channel, Mode mode, qsizetype chunk_size,
+        int max_latency) : QObject(process), _process(process),
+        _channel(channel), _mode(mode),
+        _chunk_size(chunk_size > 0 ? chunk_size : 1),
+        _max_latency(max_latency > 0 ? max_latency : 0), _scanned(0)
+{
+    _latency_timer.setSingleShot(true);
+    connect(&_latency_timer, &QTimer::timeout, this,
+            &PyQtProcessPump::batchReady);
+
+    // Note that these are connected to C++ so that the pipe is drained
+    // without acquiring the GIL.
+    if (channel == QProcess::StandardOutput)
+        connect(process, &QProcess::readyReadStandardOutput, this,
+                &PyQtProcessPump::drain);
+    else
+        connect(process, &QProcess::readyReadStandardError, this,
+                &PyQtProcessPump::drain);
+
+    connect(process, &QProcess::finished, this,
+            &PyQtProcessPump::processFinished);
+
+    // Pick up anything that has already been read.
+    drain();
+}
+
+
+// Destroy the pump.
+PyQtProcessPump::~PyQtProcessPump()
+{
+}
+
+
+// Set the maximum time in milliseconds between an item becoming available and
+// batchReady() being emitted.  0 means the next iteration of the event loop.
+void PyQtProcessPump::setMaxLatency(int max_latency)
+{
+    _max_latency = (max_latency > 0 ? max_latency : 0);
+}
+
+
+// Remove the complete items from the pump and return them as a single buffer
+// and the offsets of the end of each item.
+QByteArray PyQtProcessPump::takeBatch(QList<qint64> &ends)
+{
+    _latency_timer.stop();
+
+    ends.swap(_ends);
+    _ends.clear();
+
+    if (ends.isEmpty())
+        return QByteArray();
+
+    qsizetype batch_size = ends.last();
+    QByteArray batch;
+
+    batch.swap(_data);
+
+    // Only the incomplete item, which will be small unless in Chunks mode, is
+    // copied.
+    if (batch_size < batch.size())
+    {
+        _data = QByteArray(batch.constData() + batch_size,
+                batch.size() - batch_size);
+        batch.truncate(batch_size);
+    }
+
+    _scanned -= batch_size;
+
+    return batch;
+}
+
+
+// Read any pending data and treat any incomplete item as complete.  Emit
+// batchReady() immediately if there are any items.
+void PyQtProcessPump::flush()
+{
+    drain();
+
+    if (_data.size() > pendingBytes())
+    {
+        _ends.append(_data.size());
+        _scanned = _data.size();
+    }
+
+    if (!_ends.isEmpty())
+    {
+        _latency_timer.stop();
+        emit batchReady();
+    }
+}
+
+
+// Read all the data available from the channel.
+void PyQtProcessPump::drain()
+{
+    if (!_process)
+        return;
+
+    QByteArray data = (_channel == QProcess::StandardOutput ?
+            _process->readAllStandardOutput() :
+            _process->readAllStandardError());
+
+    if (data.isEmpty())
+        return;
+
+    // This doesn't copy the data if there is nothing pending.
+    _data.append(data);
+
+    split();
+}
+
+
+// Split any unscanned data into items.
+void PyQtProcessPump::split()
+{
+    qsizetype nr_ends = _ends.size();
+
+    if (_mode == Lines)
+    {
+        const char *data = _data.constData();
+        qsizetype size = _data.size();
+
+        while (_scanned < size)
+        {
+            const char *nl = static_cast<const char *>(
+                    memchr(data + _scanned, '\n', size - _scanned));
+
+            if (!nl)
+            {
+                _scanned = size;
+                break;
+            }
+
+            _scanned = nl - data + 1;
+            _ends.append(_scanned);
+        }
+    }
+    else
+    {
+        qint64 start = pendingBytes();
+
+        while (_data.size() - start >= _chunk_size)
+        {
+            start += _chunk_size;
+            _ends.append(start);
+        }
+
+        _scanned = _data.size();
+    }
+
+    if (_ends.size() != nr_ends)
+        schedule();
+}
+
+
+// Handle the termination of the process.
+void PyQtProcessPump::processFinished()
+{
+    flush();
+
+    emit finished();
+}
+
+
+// Make sure batchReady() will be emitted.
+void PyQtProcessPump::schedule()
+{
+    if (!_latency_timer.isActive())
+        _latency_timer.start(_max_latency);
+}
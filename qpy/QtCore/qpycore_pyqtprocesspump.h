@@ -0,0 +1,100 @@
+// This is the declaration of the PyQtProcessPump class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_PYQTPROCESSPUMP_H
+#define _QPYCORE_PYQTPROCESSPUMP_H
+
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QProcess>
+#include <QTimer>
+
+
+// This class drains one output channel of a process as it arrives and splits
+// it into lines or fixed size chunks without involving Python.  Complete items
+// are accumulated into a single buffer and batchReady() is emitted at most
+// once per batch, no later than the maximum latency after the first item of
+// the batch became available.  It is a child of the process.
+class PyQtProcessPump : public QObject
+{
+    Q_OBJECT
+
+public:
+    // How the output is split into items.
+    enum Mode {
+        Lines,
+        Chunks
+    };
+
+    PyQtProcessPump(QProcess *process,
+            QProcess::ProcessChannel channel = QProcess::StandardOutput,
+            Mode mode = Lines, qsizetype chunk_size = 65536,
+            int max_latency = 0);
+    ~PyQtProcessPump();
+
+    QProcess *process() const {return _process;}
+    QProcess::ProcessChannel channel() const {return _channel;}
+    Mode mode() const {return _mode;}
+    qsizetype chunkSize() const {return _chunk_size;}
+
+    int maxLatency() const {return _max_latency;}
+    void setMaxLatency(int max_latency);
+
+    qsizetype pendingCount() const {return _ends.size();}
+    qsizetype pendingBytes() const {return _ends.isEmpty() ? 0 : _ends.last();}
+
+    QByteArray takeBatch(QList<qint64> &ends);
+    void flush();
+
+Q_SIGNALS:
+    void batchReady();
+    void finished();
+
+private:
+    QPointer<QProcess> _process;
+    QProcess::ProcessChannel _channel;
+    Mode _mode;
+    qsizetype _chunk_size;
+    int _max_latency;
+
+    // The data read so far.  It is made up of the complete items, whose ends
+    // are in _ends, followed by any incomplete item.
+    QByteArray _data;
+    QList<qint64> _ends;
+
+    // The offset of the first byte of _data that hasn't been scanned.
+    qsizetype _scanned;
+
+    QTimer _latency_timer;
+
+    void drain();
+    void split();
+    void processFinished();
+    void schedule();
+
+    PyQtProcessPump(const PyQtProcessPump &);
+};
+
+
+#endif
@@ -35,9 +35,9 @@ PyQt_PyObject::PyQt_PyObject(PyObject *py)
 {
     pyobject = py;
 
-    SIP_BLOCK_THREADS
+    QPYCORE_BLOCK_THREADS("PyQt_PyObject::PyQt_PyObject()")
     Py_XINCREF(pyobject);
-    SIP_UNBLOCK_THREADS
+    QPYCORE_UNBLOCK_THREADS
 }
 
 
@@ -55,9 +55,9 @@ PyQt_PyObject::PyQt_PyObject(const PyQt_PyObject &other)
 {
     pyobject = other.pyobject;
 
-    SIP_BLOCK_THREADS
+    QPYCORE_BLOCK_THREADS("PyQt_PyObject::PyQt_PyObject(copy)")
     Py_XINCREF(pyobject);
-    SIP_UNBLOCK_THREADS
+    QPYCORE_UNBLOCK_THREADS
 }
 
 
@@ -68,9 +68,9 @@ PyQt_PyObject::~PyQt_PyObject()
     // hasn't.
     if (Py_IsInitialized())
     {
-        SIP_BLOCK_THREADS
+        QPYCORE_BLOCK_THREADS("PyQt_PyObject::~PyQt_PyObject()")
         Py_XDECREF(pyobject);
-        SIP_UNBLOCK_THREADS
+        QPYCORE_UNBLOCK_THREADS
     }
 
     pyobject = 0;
@@ -82,9 +82,9 @@ PyQt_PyObject &PyQt_PyObject::operator=(const PyQt_PyObject &other)
 {
     pyobject = other.pyobject;
 
-    SIP_BLOCK_THREADS
+    QPYCORE_BLOCK_THREADS("PyQt_PyObject::operator=()")
     Py_XINCREF(pyobject);
-    SIP_UNBLOCK_THREADS
+    QPYCORE_UNBLOCK_THREADS
 
     return *this;
 }
@@ -109,7 +109,7 @@ QDataStream &operator<<(QDataStream &out, const PyQt_PyObject &obj)
     {
         static PyObject *dumps = 0;
 
-        SIP_BLOCK_THREADS
+        QPYCORE_BLOCK_THREADS("PyQt_PyObject operator<<()")
 
         if (!dumps)
         {
@@ -152,16 +152,16 @@ QDataStream &operator<<(QDataStream &out, const PyQt_PyObject &obj)
             }
         }
 
-        SIP_UNBLOCK_THREADS
+        QPYCORE_UNBLOCK_THREADS
     }
 
     out.writeBytes(ser, len);
 
     if (ser_obj)
     {
-        SIP_BLOCK_THREADS
+        QPYCORE_BLOCK_THREADS("PyQt_PyObject operator<<() cleanup")
         Py_DECREF(ser_obj);
-        SIP_UNBLOCK_THREADS
+        QPYCORE_UNBLOCK_THREADS
     }
 
     return out;
@@ -180,7 +180,7 @@ QDataStream &operator>>(QDataStream &in, PyQt_PyObject &obj)
     {
         static PyObject *loads = 0;
 
-        SIP_BLOCK_THREADS
+        QPYCORE_BLOCK_THREADS("PyQt_PyObject operator>>()")
 
         if (!loads)
         {
@@ -204,7 +204,7 @@ QDataStream &operator>>(QDataStream &in, PyQt_PyObject &obj)
             }
         }
 
-        SIP_UNBLOCK_THREADS
+        QPYCORE_UNBLOCK_THREADS
     }
 
     delete[] ser;
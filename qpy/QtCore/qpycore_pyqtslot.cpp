@@ -21,7 +21,9 @@
 #include <Python.h>
 
 #include "qpycore_chimera.h"
+#include "qpycore_clock.h"
 #include "qpycore_pyqtslot.h"
+#include "qpycore_pyqtslotprofiler.h"
 
 
 // Create the slot for a callable.
@@ -68,23 +70,25 @@ PyQtSlot::~PyQtSlot()
 }
 
 
-// Invoke the slot on behalf of C++.
-PyQtSlot::Result PyQtSlot::invoke(void **qargs, bool no_receiver_check) const
+// Invoke the slot on behalf of C++.  If conversion is not 0 then the time
+// taken to convert the arguments is added to it.
+PyQtSlot::Result PyQtSlot::invoke(void **qargs, bool no_receiver_check,
+        qint64 *conversion) const
 {
-    return invoke(qargs, 0, 0, no_receiver_check);
+    return invoke(qargs, 0, 0, no_receiver_check, conversion);
 }
 
 
 // Invoke the slot on behalf of C++.
 bool PyQtSlot::invoke(void **qargs, PyObject *self, void *result) const
 {
-    return (invoke(qargs, self, result, false) != PyQtSlot::Failed);
+    return (invoke(qargs, self, result, false, 0) != PyQtSlot::Failed);
 }
 
 
 // Invoke the slot on behalf of C++.
 PyQtSlot::Result PyQtSlot::invoke(void **qargs, PyObject *self, void *result,
-        bool no_receiver_check) const
+        bool no_receiver_check, qint64 *conversion) const
 {
     // Get the callable.
     PyObject *callable;
@@ -124,6 +128,8 @@ PyQtSlot::Result PyQtSlot::invoke(void **qargs, PyObject *self, void *result,
     }
 
     // Convert the C++ arguments to Python objects.
+    qint64 conversion_start = (conversion ? qpycore_now() : 0);
+
     const QList<const Chimera *> &args = signature->parsed_arguments;
 
     PyObject *argtup = PyTuple_New(args.size());
@@ -148,6 +154,9 @@ PyQtSlot::Result PyQtSlot::invoke(void **qargs, PyObject *self, void *result,
         ++it;
     }
 
+    if (conversion)
+        *conversion += qpycore_now() - conversion_start;
+
     // Dispatch to the real slot.
     PyObject *res = call(callable, argtup);
 
@@ -202,6 +211,51 @@ bool PyQtSlot::operator==(PyObject *callable) const
 }
 
 
+// Return the qualified name of the slot for diagnostic purposes.
+QByteArray PyQtSlot::qualifiedName() const
+{
+    PyObject *func = (other ? other : mfunc);
+
+    if (!func)
+        return QByteArray();
+
+    PyObject *name = PyObject_GetAttrString(func, "__qualname__");
+
+    if (!name)
+    {
+        PyErr_Clear();
+        name = PyObject_Repr(func);
+
+        if (!name)
+        {
+            PyErr_Clear();
+            return QByteArray();
+        }
+    }
+
+    QByteArray qualname;
+
+    if (PyUnicode_Check(name))
+    {
+        PyObject *utf8 = PyUnicode_AsUTF8String(name);
+
+        if (utf8)
+        {
+            qualname = PyBytes_AsString(utf8);
+            Py_DECREF(utf8);
+        }
+        else
+        {
+            PyErr_Clear();
+        }
+    }
+
+    Py_DECREF(name);
+
+    return qualname;
+}
+
+
 // Get the instance object.
 PyObject *PyQtSlot::instance() const
 {
@@ -24,6 +24,8 @@
 
 #include <Python.h>
 
+#include <QByteArray>
+
 #include "qpycore_chimera.h"
 
 
@@ -41,9 +43,11 @@ public:
             const Chimera::Signature *slot_signature);
     ~PyQtSlot();
 
-    PyQtSlot::Result invoke(void **qargs, bool no_receiver_check) const;
+    PyQtSlot::Result invoke(void **qargs, bool no_receiver_check,
+            qint64 *conversion = 0) const;
     bool invoke(void **qargs, PyObject *self, void *result) const;
     const Chimera::Signature *slotSignature() const {return signature;}
+    QByteArray qualifiedName() const;
 
     void clearOther();
     int visitOther(visitproc visit, void *arg);
@@ -52,7 +56,7 @@ public:
 
 private:
     PyQtSlot::Result invoke(void **qargs, PyObject *self, void *result,
-            bool no_receiver_check) const;
+            bool no_receiver_check, qint64 *conversion) const;
     PyObject *call(PyObject *callable, PyObject *args) const;
     PyObject *instance() const;
 
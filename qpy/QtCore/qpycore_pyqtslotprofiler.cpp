@@ -0,0 +1,337 @@
+// This is the implementation of the PyQtSlotProfiler class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <Python.h>
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMetaObject>
+#include <QObject>
+#include <QThread>
+
+#include "qpycore_clock.h"
+#include "qpycore_pyqtslot.h"
+#include "qpycore_pyqtslotprofiler.h"
+
+
+// The identity of a connection.
+struct ProfiledConnection
+{
+    QByteArray sender_class;
+    QByteArray signal;
+    QByteArray slot;
+};
+
+
+// The statistics of a connection.
+struct ProfiledCounters
+{
+    ProfiledCounters() : count(0), total(0), max(0), conversion(0),
+            gil_wait(0), max_gil_wait(0) {}
+
+    qint64 count;
+    qint64 total;
+    qint64 max;
+    qint64 conversion;
+    qint64 gil_wait;
+    qint64 max_gil_wait;
+};
+
+
+// The statistics recorded by a thread.  These are never destroyed so that the
+// statistics of threads that have finished are included in snapshots.
+struct ProfiledThread
+{
+    QList<ProfiledCounters> counters;
+};
+
+
+// An invocation in the trace.
+struct ProfiledInvocation
+{
+    int connection_id;
+    quintptr thread_id;
+    qint64 start;
+    qint64 end;
+    qint64 wait_start;
+    qint64 conversion;
+};
+
+
+// The static members of PyQtSlotProfiler.
+std::atomic<bool> PyQtSlotProfiler::enabled(false);
+
+
+// The connections that have been profiled and their ids.
+static QList<ProfiledConnection> connections;
+static QHash<QByteArray, int> connection_ids;
+
+// The statistics of each thread.
+static QList<ProfiledThread *> threads;
+static thread_local ProfiledThread *this_thread = 0;
+
+// The trace ring buffer.
+static QList<ProfiledInvocation> trace;
+static int trace_capacity = 0;
+static int trace_next = 0;
+
+
+// Enable or disable the recording of invocations.
+void PyQtSlotProfiler::setEnabled(bool enable)
+{
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+
+// Return the maximum number of invocations kept in the trace.
+int PyQtSlotProfiler::traceCapacity()
+{
+    return trace_capacity;
+}
+
+
+// Set the maximum number of invocations kept in the trace.  0 disables the
+// trace.  The most recent invocations are kept.
+void PyQtSlotProfiler::setTraceCapacity(int capacity)
+{
+    trace_capacity = (capacity > 0 ? capacity : 0);
+    trace.clear();
+    trace.reserve(trace_capacity);
+    trace_next = 0;
+}
+
+
+// Discard all statistics and the trace.
+void PyQtSlotProfiler::reset()
+{
+    // Note that the connections are kept because slot proxies cache their ids.
+    for (ProfiledThread *thread : threads)
+        thread->counters.fill(ProfiledCounters());
+
+    trace.clear();
+    trace_next = 0;
+}
+
+
+// Return the statistics aggregated across all threads as a list of tuples.
+PyObject *PyQtSlotProfiler::snapshot()
+{
+    QList<ProfiledCounters> totals(connections.size());
+
+    for (ProfiledThread *thread : threads)
+    {
+        for (qsizetype i = 0; i < thread->counters.size(); ++i)
+        {
+            const ProfiledCounters &tc = thread->counters.at(i);
+            ProfiledCounters &c = totals[i];
+
+            c.count += tc.count;
+            c.total += tc.total;
+            c.conversion += tc.conversion;
+            c.gil_wait += tc.gil_wait;
+
+            if (c.max < tc.max)
+                c.max = tc.max;
+
+            if (c.max_gil_wait < tc.max_gil_wait)
+                c.max_gil_wait = tc.max_gil_wait;
+        }
+    }
+
+    PyObject *res = PyList_New(0);
+
+    if (!res)
+        return 0;
+
+    for (qsizetype i = 0; i < connections.size(); ++i)
+    {
+        const ProfiledCounters &c = totals.at(i);
+
+        if (c.count == 0)
+            continue;
+
+        const ProfiledConnection &conn = connections.at(i);
+
+        PyObject *entry = Py_BuildValue("(sssLddddd)",
+                conn.sender_class.constData(), conn.signal.constData(),
+                conn.slot.constData(), (long long)c.count, c.total / 1.0e9,
+                c.max / 1.0e9, c.conversion / 1.0e9, c.gil_wait / 1.0e9,
+                c.max_gil_wait / 1.0e9);
+
+        if (!entry)
+        {
+            Py_DECREF(res);
+            return 0;
+        }
+
+        int rc = PyList_Append(res, entry);
+
+        Py_DECREF(entry);
+
+        if (rc < 0)
+        {
+            Py_DECREF(res);
+            return 0;
+        }
+    }
+
+    return res;
+}
+
+
+// Return the trace in the Chrome trace event format that is also understood
+// by Perfetto.  Each invocation is a complete event with any wait for the GIL
+// as a separate event.
+QByteArray PyQtSlotProfiler::traceJson()
+{
+    QJsonArray events;
+
+    // Start with the oldest invocation.
+    qsizetype first = (trace.size() < trace_capacity ? 0 : trace_next);
+
+    for (qsizetype i = 0; i < trace.size(); ++i)
+    {
+        const ProfiledInvocation &inv = trace.at((first + i) % trace.size());
+        const ProfiledConnection &conn = connections.at(inv.connection_id);
+
+        if (inv.start > inv.wait_start)
+        {
+            QJsonObject wait;
+
+            wait.insert("name", "GIL wait");
+            wait.insert("cat", "gil");
+            wait.insert("ph", "X");
+            wait.insert("ts", inv.wait_start / 1.0e3);
+            wait.insert("dur", (inv.start - inv.wait_start) / 1.0e3);
+            wait.insert("pid", 0);
+            wait.insert("tid", qint64(inv.thread_id));
+
+            events.append(wait);
+        }
+
+        QJsonObject args;
+
+        args.insert("sender", QString::fromUtf8(conn.sender_class));
+        args.insert("signal", QString::fromUtf8(conn.signal));
+        args.insert("conversion_us", inv.conversion / 1.0e3);
+
+        QJsonObject slot;
+
+        slot.insert("name", QString::fromUtf8(conn.slot));
+        slot.insert("cat", "slot");
+        slot.insert("ph", "X");
+        slot.insert("ts", inv.start / 1.0e3);
+        slot.insert("dur", (inv.end - inv.start) / 1.0e3);
+        slot.insert("pid", 0);
+        slot.insert("tid", qint64(inv.thread_id));
+        slot.insert("args", args);
+
+        events.append(slot);
+    }
+
+    QJsonObject root;
+
+    root.insert("traceEvents", events);
+    root.insert("displayTimeUnit", "ms");
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+
+// Return the id of a connection, registering it if necessary.
+int PyQtSlotProfiler::connectionId(const QObject *sender,
+        const QByteArray &signature, const PyQtSlot *slot)
+{
+    ProfiledConnection conn;
+
+    if (sender)
+        conn.sender_class = sender->metaObject()->className();
+
+    conn.signal = signature;
+    conn.slot = slot->qualifiedName();
+
+    QByteArray key = conn.sender_class + '\0' + conn.signal + '\0' + conn.slot;
+
+    QHash<QByteArray, int>::const_iterator it = connection_ids.constFind(key);
+
+    if (it != connection_ids.constEnd())
+        return it.value();
+
+    int id = connections.size();
+
+    connections.append(conn);
+    connection_ids.insert(key, id);
+
+    return id;
+}
+
+
+// Record an invocation of a connection.  The times are those returned by
+// qpycore_now().
+void PyQtSlotProfiler::record(int connection_id, qint64 wait_start,
+        qint64 start, qint64 end, qint64 conversion)
+{
+    if (!this_thread)
+    {
+        this_thread = new ProfiledThread;
+        threads.append(this_thread);
+    }
+
+    if (this_thread->counters.size() <= connection_id)
+        this_thread->counters.resize(connection_id + 1);
+
+    ProfiledCounters &c = this_thread->counters[connection_id];
+    qint64 wall = end - start;
+    qint64 gil_wait = start - wait_start;
+
+    ++c.count;
+    c.total += wall;
+    c.conversion += conversion;
+    c.gil_wait += gil_wait;
+
+    if (c.max < wall)
+        c.max = wall;
+
+    if (c.max_gil_wait < gil_wait)
+        c.max_gil_wait = gil_wait;
+
+    if (trace_capacity > 0)
+    {
+        ProfiledInvocation inv;
+
+        inv.connection_id = connection_id;
+        inv.thread_id = quintptr(QThread::currentThreadId());
+        inv.start = start;
+        inv.end = end;
+        inv.wait_start = wait_start;
+        inv.conversion = conversion;
+
+        if (trace.size() < trace_capacity)
+            trace.append(inv);
+        else
+            trace[trace_next] = inv;
+
+        trace_next = (trace_next + 1) % trace_capacity;
+    }
+}
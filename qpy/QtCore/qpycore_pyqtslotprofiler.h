@@ -0,0 +1,79 @@
+// This is the declaration of the PyQtSlotProfiler class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYCORE_PYQTSLOTPROFILER_H
+#define _QPYCORE_PYQTSLOTPROFILER_H
+
+
+#include <Python.h>
+
+#include <atomic>
+
+#include <QByteArray>
+#include <QString>
+
+#include "qpycore_namespace.h"
+
+
+QT_BEGIN_NAMESPACE
+class QObject;
+QT_END_NAMESPACE
+
+class PyQtSlot;
+
+
+// This class records the invocations of Python slots made by slot proxies.
+// Statistics are kept per connection, identified by the class of the sender,
+// the signal signature and the qualified name of the slot.  They are
+// accumulated in per-thread tables that are aggregated when a snapshot is
+// taken.  Everything except isEnabled() must be called with the GIL held.
+class PyQtSlotProfiler
+{
+public:
+    // Return true if invocations are being recorded.  This is called without
+    // the GIL.
+    static bool isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enable);
+
+    static int traceCapacity();
+    static void setTraceCapacity(int capacity);
+
+    static void reset();
+    static PyObject *snapshot();
+    static QByteArray traceJson();
+
+    static int connectionId(const QObject *sender,
+            const QByteArray &signature, const PyQtSlot *slot);
+    static void record(int connection_id, qint64 wait_start, qint64 start,
+            qint64 end, qint64 conversion);
+
+private:
+    static std::atomic<bool> enabled;
+
+    PyQtSlotProfiler();
+};
+
+
+#endif
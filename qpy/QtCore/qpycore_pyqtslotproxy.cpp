@@ -21,14 +21,18 @@
 #include <Python.h>
 
 #include <QByteArray>
+#include <QList>
 #include <QMetaObject>
 #include <QObject>
 #include <QRecursiveMutex>
 
 #include "qpycore_api.h"
 #include "qpycore_chimera.h"
+#include "qpycore_clock.h"
+#include "qpycore_pyqteventloopmonitor.h"
 #include "qpycore_qmetaobjectbuilder.h"
 #include "qpycore_pyqtslot.h"
+#include "qpycore_pyqtslotprofiler.h"
 #include "qpycore_pyqtslotproxy.h"
 
 #include "sipAPIQtCore.h"
@@ -45,7 +49,7 @@
 
 
 // The last QObject sender.
-QObject *PyQtSlotProxy::last_sender = 0;
+thread_local QObject *PyQtSlotProxy::last_sender = 0;
 
 
 // Create a universal proxy used as a slot.  Note that this will leak if there
@@ -55,11 +59,12 @@ QObject *PyQtSlotProxy::last_sender = 0;
 PyQtSlotProxy::PyQtSlotProxy(PyObject *slot, QObject *q_tx,
         const Chimera::Signature *slot_signature, bool single_shot)
     : QObject(), proxy_flags(single_shot ? PROXY_SINGLE_SHOT : 0),
-        signature(slot_signature->signature), transmitter(q_tx)
+        signature(slot_signature->signature), transmitter(q_tx),
+        profiler_id(-1)
 {
-    SIP_BLOCK_THREADS
+    QPYCORE_BLOCK_THREADS("PyQtSlotProxy::PyQtSlotProxy()")
     real_slot = new PyQtSlot(slot, false, slot_signature);
-    SIP_UNBLOCK_THREADS
+    QPYCORE_UNBLOCK_THREADS
 
     // Create a new meta-object on the heap so that it looks like it has a slot
     // of the right name and signature.
@@ -119,9 +124,9 @@ PyQtSlotProxy::~PyQtSlotProxy()
     // hasn't.
     if (Py_IsInitialized())
     {
-        SIP_BLOCK_THREADS
+        QPYCORE_BLOCK_THREADS("PyQtSlotProxy::~PyQtSlotProxy()")
         delete real_slot;
-        SIP_UNBLOCK_THREADS
+        QPYCORE_UNBLOCK_THREADS
     }
 
     if (meta_object)
@@ -195,14 +200,43 @@ void PyQtSlotProxy::unislot(void **qargs)
     // between the GIL and Qt's internal thread data mutex.
     QObject *new_last_sender = sender();
 
-    SIP_BLOCK_THREADS
+    // The profiler is checked before acquiring the GIL so that the time spent
+    // waiting for it can be measured.
+    bool profiling = PyQtSlotProfiler::isEnabled();
+    qint64 wait_start = (profiling ? qpycore_now() : 0);
+
+    QPYCORE_BLOCK_THREADS("PyQtSlotProxy::unislot()")
+
+    qint64 start = (profiling ? qpycore_now() : 0);
+    qint64 conversion = 0;
 
     QObject *saved_last_sender = last_sender;
     last_sender = new_last_sender;
 
+    // The connection is identified before invoking the slot as the slot may
+    // destroy the sender.
+    if (profiling && profiler_id < 0)
+        profiler_id = PyQtSlotProfiler::connectionId(
+                (transmitter ? transmitter : new_last_sender), signature,
+                real_slot);
+
     proxy_flags |= PROXY_SLOT_INVOKED;
 
-    switch (real_slot->invoke(qargs, (proxy_flags & PROXY_NO_RCVR_CHECK)))
+    // Tell any event loop monitor so that the slot can be blamed for a stall.
+    PyQtEventLoopMonitor *monitor = PyQtEventLoopMonitor::current();
+    const PyQtSlot *outer_slot = 0;
+    qint64 monitor_start = (monitor ?
+            monitor->handlerStarted(real_slot, &outer_slot) : 0);
+
+    PyQtSlot::Result result = real_slot->invoke(qargs,
+            (proxy_flags & PROXY_NO_RCVR_CHECK),
+            (profiling ? &conversion : 0));
+
+    // The slot may have stopped the monitor.
+    if (monitor && monitor == PyQtEventLoopMonitor::current())
+        monitor->handlerFinished(real_slot, outer_slot, monitor_start);
+
+    switch (result)
     {
     case PyQtSlot::Succeeded:
         break;
@@ -218,6 +252,14 @@ void PyQtSlotProxy::unislot(void **qargs)
 
     proxy_flags &= ~PROXY_SLOT_INVOKED;
 
+    if (profiling && result != PyQtSlot::Ignored)
+    {
+        qint64 end = qpycore_now();
+
+        PyQtSlotProfiler::record(profiler_id, wait_start, start, end,
+                conversion);
+    }
+
     // Self destruct if we are a single shot or disabled.
     if (proxy_flags & (PROXY_SINGLE_SHOT|PROXY_SLOT_DISABLED))
     {
@@ -227,7 +269,7 @@ void PyQtSlotProxy::unislot(void **qargs)
 
     last_sender = saved_last_sender;
 
-    SIP_UNBLOCK_THREADS
+    QPYCORE_UNBLOCK_THREADS
 }
 
 
@@ -338,19 +380,43 @@ void PyQtSlotProxy::deleteSlotProxies(const QObject *transmitter,
 
 
 // Clear the extra references of any slots connected to a transmitter.  This is
-// called with the GIL.
+// called with the GIL.  Note that proxies may be created and destroyed by
+// other threads without the GIL so the hash must still be protected.
+// However, clearing a reference may run arbitrary Python code (which may
+// connect or disconnect and so need the mutex) so the mutex is not held while
+// doing so.
 int PyQtSlotProxy::clearSlotProxies(const QObject *transmitter)
 {
+    QList<PyQtSlotProxy *> proxies;
+
+    mutex->lock();
+
     ProxyHash::iterator it(proxy_slots.find(transmitter));
     ProxyHash::iterator end(proxy_slots.end());
 
     while (it != end && it.key() == transmitter)
     {
-        it.value()->real_slot->clearOther();
+        proxies.append(it.value());
 
         ++it;
     }
 
+    mutex->unlock();
+
+    for (PyQtSlotProxy *proxy : proxies)
+    {
+        // The Python code run by a previous clear may have released the GIL
+        // and allowed the proxy to be destroyed.  Its slot is only destroyed
+        // with the GIL, so if the proxy is still in the hash then its slot is
+        // safe to use until we release the GIL.
+        mutex->lock();
+        bool exists = proxy_slots.contains(transmitter, proxy);
+        mutex->unlock();
+
+        if (exists)
+            proxy->real_slot->clearOther();
+    }
+
     return 0;
 }
 
@@ -363,12 +429,15 @@ int qpycore_clearSlotProxies(const QObject *transmitter)
 
 
 // Visit the extra references of any slots connected to a transmitter.  This is
-// called with the GIL.
+// called with the GIL.  Unlike clearing, visiting doesn't run any Python code
+// so the mutex can be held throughout.
 int PyQtSlotProxy::visitSlotProxies(const QObject *transmitter,
         visitproc visit, void *arg)
 {
     int vret = 0;
 
+    mutex->lock();
+
     ProxyHash::iterator it(proxy_slots.find(transmitter));
     ProxyHash::iterator end(proxy_slots.end());
 
@@ -380,6 +449,8 @@ int PyQtSlotProxy::visitSlotProxies(const QObject *transmitter,
         ++it;
     }
 
+    mutex->unlock();
+
     return vret;
 }
 
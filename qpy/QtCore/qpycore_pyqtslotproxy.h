@@ -84,8 +84,10 @@ public:
     QMetaObject::Connection connection;
 
 private:
-    // The last QObject sender.
-    static QObject *last_sender;
+    // The last QObject sender.  This is per-thread because the GIL may be
+    // released while a slot is executing and another thread may then invoke
+    // a slot of its own.
+    static thread_local QObject *last_sender;
 
     // The type of a proxy hash.
     typedef QMultiHash<const QObject *, PyQtSlotProxy *> ProxyHash;
@@ -108,6 +110,10 @@ private:
     // The meta-object.
     const QMetaObject *meta_object;
 
+    // The id of the connection used by the profiler (if it has been
+    // allocated).
+    int profiler_id;
+
     PyQtSlotProxy(const PyQtSlotProxy &);
     PyQtSlotProxy &operator=(const PyQtSlotProxy &);
 };
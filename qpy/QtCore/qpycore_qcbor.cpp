@@ -0,0 +1,502 @@
+// This is the support for streaming native Python objects to and from CBOR.
+// 
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+#include <Python.h>
+
+#include <QByteArray>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QString>
+
+#include "qpycore_api.h"
+#include "qpycore_misc.h"
+
+#include "sipAPIQtCore.h"
+
+
+// Forward declarations.
+static PyObject *read_item(QCborStreamReader &reader, PyQtStringCache &keys);
+static PyObject *read_value(QCborStreamReader &reader, PyQtStringCache &keys);
+static bool write_value(QCborStreamWriter &writer, PyObject *obj);
+static PyObject *read_string(QCborStreamReader &reader,
+        PyQtStringCache *keys);
+static PyObject *read_byte_array(QCborStreamReader &reader);
+static PyObject *read_negative_integer(QCborStreamReader &reader);
+static void raise_reader_error(QCborStreamReader &reader);
+
+
+// Read the next complete item from a CBOR stream and return it as a native
+// Python object without creating an intermediate QCborValue.  Tags are
+// discarded and the tagged item is returned.
+PyObject *qpycore_read_cbor(QCborStreamReader &reader)
+{
+    PyQtStringCache keys;
+
+    return read_item(reader, keys);
+}
+
+
+// Write a native Python object to a CBOR stream without creating an
+// intermediate QCborValue.
+bool qpycore_write_cbor(QCborStreamWriter &writer, PyObject *obj)
+{
+    if (!PyDict_Check(obj) && !PyList_Check(obj) && !PyTuple_Check(obj))
+        return write_value(writer, obj);
+
+    // Containers may be self-referential or very deeply nested.
+    if (Py_EnterRecursiveCall(" while writing CBOR"))
+        return false;
+
+    bool ok = write_value(writer, obj);
+
+    Py_LeaveRecursiveCall();
+
+    return ok;
+}
+
+
+// Write a native Python object, and any contained objects, to a CBOR stream.
+static bool write_value(QCborStreamWriter &writer, PyObject *obj)
+{
+    if (obj == Py_None)
+    {
+        writer.appendNull();
+        return true;
+    }
+
+    // Note that bool must be checked before int.
+    if (PyBool_Check(obj))
+    {
+        writer.append(obj == Py_True);
+        return true;
+    }
+
+    if (PyLong_Check(obj))
+    {
+        int overflow;
+        long long ll = PyLong_AsLongLongAndOverflow(obj, &overflow);
+
+        if (overflow > 0)
+        {
+            unsigned long long ull = PyLong_AsUnsignedLongLong(obj);
+
+            if (PyErr_Occurred())
+                return false;
+
+            writer.append(static_cast<quint64>(ull));
+        }
+        else if (overflow < 0)
+        {
+            PyErr_SetString(PyExc_OverflowError,
+                    "int is too small to be converted to CBOR");
+
+            return false;
+        }
+        else
+        {
+            if (PyErr_Occurred())
+                return false;
+
+            writer.append(static_cast<qint64>(ll));
+        }
+
+        return true;
+    }
+
+    if (PyFloat_Check(obj))
+    {
+        writer.append(PyFloat_AsDouble(obj));
+        return true;
+    }
+
+    if (PyUnicode_Check(obj))
+    {
+        writer.append(qpycore_PyObject_AsQString(obj));
+        return true;
+    }
+
+    if (PyDict_Check(obj))
+    {
+        writer.startMap(PyDict_Size(obj));
+
+        Py_ssize_t pos = 0;
+        PyObject *key_obj, *value_obj;
+
+        while (PyDict_Next(obj, &pos, &key_obj, &value_obj))
+        {
+            if (!qpycore_write_cbor(writer, key_obj))
+                return false;
+
+            if (!qpycore_write_cbor(writer, value_obj))
+                return false;
+        }
+
+        writer.endMap();
+
+        return true;
+    }
+
+    if (PyList_Check(obj) || PyTuple_Check(obj))
+    {
+        bool is_list = PyList_Check(obj);
+        Py_ssize_t size = (is_list ? PyList_Size(obj) : PyTuple_Size(obj));
+
+        writer.startArray(size);
+
+        for (Py_ssize_t i = 0; i < size; ++i)
+        {
+            PyObject *el_obj = (is_list ? PyList_GetItem(obj, i) :
+                    PyTuple_GetItem(obj, i));
+
+            if (!el_obj)
+                return false;
+
+            if (!qpycore_write_cbor(writer, el_obj))
+                return false;
+        }
+
+        writer.endArray();
+
+        return true;
+    }
+
+    // Anything else must support the buffer protocol.
+    sipBufferInfoDef bi;
+
+    if (sipGetBufferInfo(obj, &bi) > 0)
+    {
+        writer.appendByteString(reinterpret_cast<const char *>(bi.bi_buf),
+                bi.bi_len);
+
+        sipReleaseBufferInfo(&bi);
+
+        return true;
+    }
+
+    if (!PyErr_Occurred())
+        PyErr_Format(PyExc_TypeError,
+                "'%s' object cannot be converted to CBOR",
+                sipPyTypeName(Py_TYPE(obj)));
+
+    return false;
+}
+
+
+// Read the next item and any contained items.
+static PyObject *read_item(QCborStreamReader &reader, PyQtStringCache &keys)
+{
+    // Tags are discarded.  They may be chained so they are skipped
+    // iteratively.
+    while (reader.isTag())
+        if (!reader.next())
+            break;
+
+    if (!reader.isContainer())
+        return read_value(reader, keys);
+
+    // Containers may be very deeply nested, particularly if the data is
+    // untrusted.
+    if (Py_EnterRecursiveCall(" while reading CBOR"))
+        return 0;
+
+    PyObject *obj = read_value(reader, keys);
+
+    Py_LeaveRecursiveCall();
+
+    return obj;
+}
+
+
+// Read the next item, which may be a container but not a tag.
+static PyObject *read_value(QCborStreamReader &reader, PyQtStringCache &keys)
+{
+    PyObject *obj;
+
+    switch (reader.type())
+    {
+    case QCborStreamReader::UnsignedInteger:
+        obj = PyLong_FromUnsignedLongLong(reader.toUnsignedInteger());
+        reader.next();
+        break;
+
+    case QCborStreamReader::NegativeInteger:
+        obj = read_negative_integer(reader);
+        reader.next();
+        break;
+
+    case QCborStreamReader::ByteArray:
+        obj = read_byte_array(reader);
+        break;
+
+    case QCborStreamReader::String:
+        obj = read_string(reader, 0);
+        break;
+
+    case QCborStreamReader::Array:
+        if (!reader.enterContainer())
+        {
+            raise_reader_error(reader);
+            return 0;
+        }
+
+        obj = PyList_New(0);
+
+        if (!obj)
+            return 0;
+
+        while (reader.hasNext())
+        {
+            PyObject *el_obj = read_item(reader, keys);
+
+            if (!el_obj)
+            {
+                Py_DECREF(obj);
+                return 0;
+            }
+
+            int rc = PyList_Append(obj, el_obj);
+
+            Py_DECREF(el_obj);
+
+            if (rc < 0)
+            {
+                Py_DECREF(obj);
+                return 0;
+            }
+        }
+
+        if (!reader.leaveContainer())
+        {
+            Py_DECREF(obj);
+            raise_reader_error(reader);
+            return 0;
+        }
+
+        break;
+
+    case QCborStreamReader::Map:
+        if (!reader.enterContainer())
+        {
+            raise_reader_error(reader);
+            return 0;
+        }
+
+        obj = PyDict_New();
+
+        if (!obj)
+            return 0;
+
+        while (reader.hasNext())
+        {
+            // String keys are cached as they are typically repeated.
+            PyObject *key_obj = (reader.isString() ?
+                    read_string(reader, &keys) : read_item(reader, keys));
+
+            if (!key_obj)
+            {
+                Py_DECREF(obj);
+                return 0;
+            }
+
+            PyObject *value_obj = read_item(reader, keys);
+
+            if (!value_obj)
+            {
+                Py_DECREF(key_obj);
+                Py_DECREF(obj);
+                return 0;
+            }
+
+            int rc = PyDict_SetItem(obj, key_obj, value_obj);
+
+            Py_DECREF(value_obj);
+            Py_DECREF(key_obj);
+
+            if (rc < 0)
+            {
+                Py_DECREF(obj);
+                return 0;
+            }
+        }
+
+        if (!reader.leaveContainer())
+        {
+            Py_DECREF(obj);
+            raise_reader_error(reader);
+            return 0;
+        }
+
+        break;
+
+    case QCborStreamReader::SimpleType:
+        switch (reader.toSimpleType())
+        {
+        case QCborSimpleType::False:
+            obj = PyBool_FromLong(0);
+            break;
+
+        case QCborSimpleType::True:
+            obj = PyBool_FromLong(1);
+            break;
+
+        case QCborSimpleType::Null:
+        case QCborSimpleType::Undefined:
+            Py_INCREF(Py_None);
+            obj = Py_None;
+            break;
+
+        default:
+            obj = PyLong_FromLong(static_cast<long>(reader.toSimpleType()));
+        }
+
+        reader.next();
+        break;
+
+    case QCborStreamReader::Float16:
+        obj = PyFloat_FromDouble(reader.toFloat16());
+        reader.next();
+        break;
+
+    case QCborStreamReader::Float:
+        obj = PyFloat_FromDouble(reader.toFloat());
+        reader.next();
+        break;
+
+    case QCborStreamReader::Double:
+        obj = PyFloat_FromDouble(reader.toDouble());
+        reader.next();
+        break;
+
+    default:
+        raise_reader_error(reader);
+        return 0;
+    }
+
+    if (obj && reader.lastError() != QCborError::NoError)
+    {
+        Py_DECREF(obj);
+        raise_reader_error(reader);
+        return 0;
+    }
+
+    return obj;
+}
+
+
+// Read a (possibly chunked) text string optionally using a cache.
+static PyObject *read_string(QCborStreamReader &reader, PyQtStringCache *keys)
+{
+    QString data;
+    QCborStreamReader::StringResult<QString> res = reader.readString();
+
+    while (res.status == QCborStreamReader::Ok)
+    {
+        data.append(res.data);
+        res = reader.readString();
+    }
+
+    if (res.status == QCborStreamReader::Error)
+    {
+        raise_reader_error(reader);
+        return 0;
+    }
+
+    return (keys ? keys->get(data) : qpycore_PyObject_FromQString(data));
+}
+
+
+// Read a (possibly chunked) byte string.
+static PyObject *read_byte_array(QCborStreamReader &reader)
+{
+    QByteArray data;
+    QCborStreamReader::StringResult<QByteArray> res = reader.readByteArray();
+
+    while (res.status == QCborStreamReader::Ok)
+    {
+        data.append(res.data);
+        res = reader.readByteArray();
+    }
+
+    if (res.status == QCborStreamReader::Error)
+    {
+        raise_reader_error(reader);
+        return 0;
+    }
+
+    return PyBytes_FromStringAndSize(data.constData(), data.size());
+}
+
+
+// Read a negative integer which may be outside the range of a qint64.
+static PyObject *read_negative_integer(QCborStreamReader &reader)
+{
+    // The absolute value is stored, with 0 representing -2^64.
+    quint64 abs_value = quint64(reader.toNegativeInteger());
+
+    if (abs_value != 0 && abs_value <= quint64(1) << 63)
+        return PyLong_FromLongLong(reader.toInteger());
+
+    PyObject *abs_obj;
+
+    if (abs_value == 0)
+    {
+        PyObject *max_obj = PyLong_FromUnsignedLongLong(~quint64(0));
+
+        if (!max_obj)
+            return 0;
+
+        PyObject *one_obj = PyLong_FromLong(1);
+
+        if (!one_obj)
+        {
+            Py_DECREF(max_obj);
+            return 0;
+        }
+
+        abs_obj = PyNumber_Add(max_obj, one_obj);
+
+        Py_DECREF(one_obj);
+        Py_DECREF(max_obj);
+    }
+    else
+    {
+        abs_obj = PyLong_FromUnsignedLongLong(abs_value);
+    }
+
+    if (!abs_obj)
+        return 0;
+
+    PyObject *obj = PyNumber_Negative(abs_obj);
+
+    Py_DECREF(abs_obj);
+
+    return obj;
+}
+
+
+// Raise an exception describing the reader's last error.
+static void raise_reader_error(QCborStreamReader &reader)
+{
+    QCborError error = reader.lastError();
+    QString msg = (error == QCborError::NoError ?
+            QString("unexpected CBOR data") : error.toString());
+
+    PyErr_SetString(PyExc_ValueError, msg.toUtf8().constData());
+}
@@ -0,0 +1,339 @@
+// This is the support for reading QDataStream data into Python buffers.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <Python.h>
+
+#include <QDataStream>
+#include <QtEndian>
+
+#include "qpycore_api.h"
+
+#include "sipAPIQtCore.h"
+
+
+// The largest block read in one go so that versions of Qt that use an int for
+// the length can be supported.
+static const qint64 max_block = 0x40000000;
+
+
+// Forward declarations.
+static bool get_writable_buffer(PyObject *buffer, sipBufferInfoDef *bi);
+static qint64 read_raw(QDataStream &ds, char *data, qint64 len);
+static qint64 read_block_size(QDataStream &ds);
+static void to_host(QDataStream::ByteOrder order, void *data,
+        qint64 nr_items, int item_size);
+template<typename S, typename D>
+static qint64 read_converted(QDataStream &ds, D *data, qint64 nr_items);
+
+
+// Read a block of bytes (as written by writeBytes()) directly into a buffer.
+// Return the number of bytes read or -1 if there was an error.
+qint64 qpycore_qdatastream_read_bytes_into(QDataStream *ds, PyObject *buffer)
+{
+    sipBufferInfoDef bi;
+
+    if (!get_writable_buffer(buffer, &bi))
+        return -1;
+
+    qint64 len, nr_read = 0;
+
+    Py_BEGIN_ALLOW_THREADS
+
+    len = read_block_size(*ds);
+
+    if (len > bi.bi_len)
+    {
+        // Skip the block so that the stream is left in a consistent state.
+        for (qint64 skipped = 0; skipped < len; )
+        {
+            qint64 s = ds->skipRawData(qMin(len - skipped, max_block));
+
+            if (s <= 0)
+                break;
+
+            skipped += s;
+        }
+    }
+    else if (len > 0)
+    {
+        nr_read = read_raw(*ds, reinterpret_cast<char *>(bi.bi_buf), len);
+    }
+
+    Py_END_ALLOW_THREADS
+
+    sipReleaseBufferInfo(&bi);
+
+    if (len > bi.bi_len)
+    {
+        PyErr_Format(PyExc_ValueError,
+                "the buffer is too small for the %lld bytes that were read",
+                len);
+
+        return -1;
+    }
+
+    return nr_read;
+}
+
+
+// Read as many items as will fit into a buffer.  The format of the buffer
+// determines the type of the items.  The stream's byte order and floating
+// point precision are honoured.  Return the number of complete items read or
+// -1 if there was an error.
+qint64 qpycore_qdatastream_read_array(QDataStream *ds, PyObject *buffer)
+{
+    sipBufferInfoDef bi;
+
+    if (!get_writable_buffer(buffer, &bi))
+        return -1;
+
+    // Allow a native byte order prefix.
+    const char *format = bi.bi_format;
+
+    if (format && (*format == '@' || *format == '='))
+        ++format;
+
+    bool is_float = false;
+    int item_size = 0;
+
+    if (format && format[0] != '\0' && format[1] == '\0')
+    {
+        switch (format[0])
+        {
+        case 'b':
+        case 'B':
+        case 'c':
+        case '?':
+            item_size = 1;
+            break;
+
+        case 'h':
+        case 'H':
+            item_size = 2;
+            break;
+
+        case 'i':
+        case 'I':
+            item_size = 4;
+            break;
+
+        case 'l':
+        case 'L':
+            item_size = sizeof (long);
+            break;
+
+        case 'q':
+        case 'Q':
+            item_size = 8;
+            break;
+
+        case 'f':
+            is_float = true;
+            item_size = sizeof (float);
+            break;
+
+        case 'd':
+            is_float = true;
+            item_size = sizeof (double);
+            break;
+        }
+    }
+
+    if (item_size == 0)
+    {
+        PyErr_Format(PyExc_TypeError, "unsupported buffer format '%s'",
+                bi.bi_format ? bi.bi_format : "");
+
+        sipReleaseBufferInfo(&bi);
+
+        return -1;
+    }
+
+    qint64 nr_items = bi.bi_len / item_size, nr_read;
+
+    Py_BEGIN_ALLOW_THREADS
+
+    // Floats are written as doubles unless single precision has been set and
+    // vice versa.
+    int stream_float_size = sizeof (double);
+
+    if (ds->floatingPointPrecision() == QDataStream::SinglePrecision)
+        stream_float_size = sizeof (float);
+
+    if (is_float && item_size != stream_float_size)
+    {
+        if (item_size == sizeof (float))
+            nr_read = read_converted<double>(*ds,
+                    reinterpret_cast<float *>(bi.bi_buf), nr_items);
+        else
+            nr_read = read_converted<float>(*ds,
+                    reinterpret_cast<double *>(bi.bi_buf), nr_items);
+    }
+    else
+    {
+        nr_read = read_raw(*ds, reinterpret_cast<char *>(bi.bi_buf),
+                nr_items * item_size) / item_size;
+
+        to_host(ds->byteOrder(), bi.bi_buf, nr_read, item_size);
+    }
+
+    Py_END_ALLOW_THREADS
+
+    sipReleaseBufferInfo(&bi);
+
+    return nr_read;
+}
+
+
+// Get a writable buffer.  Return false and raise an exception if there was an
+// error.
+static bool get_writable_buffer(PyObject *buffer, sipBufferInfoDef *bi)
+{
+    if (sipGetBufferInfo(buffer, bi) <= 0)
+        return false;
+
+    if (bi->bi_readonly)
+    {
+        PyErr_SetString(PyExc_TypeError, "the buffer is read-only");
+        sipReleaseBufferInfo(bi);
+
+        return false;
+    }
+
+    return true;
+}
+
+
+// Read raw data from a stream in blocks.  Any error is reflected in the
+// stream's status.  Return the number of bytes read.
+static qint64 read_raw(QDataStream &ds, char *data, qint64 len)
+{
+    qint64 nr_read = 0;
+
+    while (nr_read < len)
+    {
+        qint64 block = qMin(len - nr_read, max_block);
+        qint64 r = ds.readRawData(data + nr_read, block);
+
+        if (r <= 0)
+            break;
+
+        nr_read += r;
+
+        if (r < block)
+            break;
+    }
+
+    return nr_read;
+}
+
+
+// Read the size of a block written by writeBytes().  Return a negative value
+// if there was an error or the block was null.
+static qint64 read_block_size(QDataStream &ds)
+{
+    quint32 first;
+
+    ds >> first;
+
+    if (ds.status() != QDataStream::Ok || first == 0xffffffffu)
+        return -1;
+
+#if QT_VERSION >= 0x060700
+    if (first == 0xfffffffeu && ds.version() >= QDataStream::Qt_6_7)
+    {
+        qint64 extended;
+
+        ds >> extended;
+
+        if (ds.status() != QDataStream::Ok)
+            return -1;
+
+        return extended;
+    }
+#endif
+
+    return first;
+}
+
+
+// Convert items read from a stream to the host byte order.  This uses Qt's
+// vectorised byte swapping.
+static void to_host(QDataStream::ByteOrder order, void *data,
+        qint64 nr_items, int item_size)
+{
+    switch (item_size)
+    {
+    case 2:
+        if (order == QDataStream::BigEndian)
+            qFromBigEndian<quint16>(data, nr_items, data);
+        else
+            qFromLittleEndian<quint16>(data, nr_items, data);
+
+        break;
+
+    case 4:
+        if (order == QDataStream::BigEndian)
+            qFromBigEndian<quint32>(data, nr_items, data);
+        else
+            qFromLittleEndian<quint32>(data, nr_items, data);
+
+        break;
+
+    case 8:
+        if (order == QDataStream::BigEndian)
+            qFromBigEndian<quint64>(data, nr_items, data);
+        else
+            qFromLittleEndian<quint64>(data, nr_items, data);
+
+        break;
+    }
+}
+
+
+// Read floating point items of one precision and convert them to another.
+// Return the number of complete items read.
+template<typename S, typename D>
+static qint64 read_converted(QDataStream &ds, D *data, qint64 nr_items)
+{
+    S chunk[1024];
+    qint64 nr_read = 0;
+
+    while (nr_read < nr_items)
+    {
+        qint64 n = qMin(nr_items - nr_read,
+                qint64(sizeof (chunk) / sizeof (S)));
+        qint64 r = read_raw(ds, reinterpret_cast<char *>(chunk),
+                n * sizeof (S)) / sizeof (S);
+
+        to_host(ds.byteOrder(), chunk, r, sizeof (S));
+
+        for (qint64 i = 0; i < r; ++i)
+            *data++ = static_cast<D>(chunk[i]);
+
+        nr_read += r;
+
+        if (r < n)
+            break;
+    }
+
+    return nr_read;
+}
@@ -20,11 +20,27 @@
 
 #include <Python.h>
 
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMetaType>
+#include <QString>
+#include <QVariant>
+
 #include "qpycore_api.h"
+#include "qpycore_misc.h"
 
 #include "sipAPIQtCore.h"
 
 
+// Forward declarations.
+static PyObject *from_qjsonvalue(const QJsonValue &value,
+        PyQtStringCache &keys);
+static bool as_native_qjsonvalue(PyObject *obj, QJsonValue &value);
+static bool as_native_container(PyObject *obj, QJsonValue &value);
+static bool is_native(PyObject *obj);
+
+
 // See if a Python object can be converted to a QJsonValue.
 int qpycore_canConvertTo_QJsonValue(PyObject *py)
 {
@@ -32,13 +48,7 @@ int qpycore_canConvertTo_QJsonValue(PyObject *py)
     if (PyObject_TypeCheck(py, sipTypeAsPyTypeObject(sipType_QJsonValue_Type)))
         return 1;
 
-    if (PyBool_Check(py))
-        return 1;
-
-    if (PyLong_Check(py))
-        return 1;
-
-    if (PyFloat_Check(py))
+    if (is_native(py))
         return 1;
 
     if (sipCanConvertToType(py, sipType_QString, 0))
@@ -82,23 +92,20 @@ int qpycore_convertTo_QJsonValue(PyObject *py, PyObject *transferObj,
         return sipGetState(transferObj);
     }
 
-    if (PyBool_Check(py))
+    // Handle native Python types (including containers) in a single pass.
+    if (is_native(py))
     {
-        *cpp = new QJsonValue(py == Py_True);
+        QJsonValue *value = new QJsonValue;
 
-        return sipGetState(transferObj);
-    }
+        if (!as_native_qjsonvalue(py, *value))
+        {
+            delete value;
+            *isErr = 1;
 
-    if (PyLong_Check(py))
-    {
-        *cpp = new QJsonValue((qint64)PyLong_AsLong(py));
+            return 0;
+        }
 
-        return sipGetState(transferObj);
-    }
-
-    if (PyFloat_Check(py))
-    {
-        *cpp = new QJsonValue((double)PyFloat_AsDouble(py));
+        *cpp = value;
 
         return sipGetState(transferObj);
     }
@@ -161,3 +168,285 @@ int qpycore_convertTo_QJsonValue(PyObject *py, PyObject *transferObj,
         return sipGetState(transferObj);
     }
 }
+
+
+// Convert a QJsonValue to the corresponding native Python object.
+PyObject *qpycore_PyObject_FromQJsonValue(const QJsonValue &value)
+{
+    PyQtStringCache keys;
+
+    return from_qjsonvalue(value, keys);
+}
+
+
+// Convert a Python object to a QJsonValue.  Native Python types are converted
+// directly, anything else is converted as if it was the argument to a method
+// expecting a QJsonValue.
+bool qpycore_PyObject_AsQJsonValue(PyObject *obj, QJsonValue &value)
+{
+    if (obj == Py_None)
+    {
+        value = QJsonValue();
+        return true;
+    }
+
+    if (is_native(obj))
+        return as_native_qjsonvalue(obj, value);
+
+    int state, iserr = 0;
+
+    QJsonValue *qjv = reinterpret_cast<QJsonValue *>(
+            sipForceConvertToType(obj, sipType_QJsonValue, 0, SIP_NOT_NONE,
+                    &state, &iserr));
+
+    if (iserr)
+        return false;
+
+    value = *qjv;
+
+    sipReleaseType(qjv, sipType_QJsonValue, state);
+
+    return true;
+}
+
+
+// Convert a QJsonValue to a Python object using a cache of dict keys.
+static PyObject *from_qjsonvalue(const QJsonValue &value,
+        PyQtStringCache &keys)
+{
+    PyObject *obj;
+
+    switch (value.type())
+    {
+    case QJsonValue::Bool:
+        obj = PyBool_FromLong(value.toBool());
+        break;
+
+    case QJsonValue::Double:
+        {
+            // Integers are stored separately so that we can preserve the
+            // distinction between int and float.
+            QVariant number = value.toVariant();
+
+            if (number.typeId() == QMetaType::LongLong)
+                obj = PyLong_FromLongLong(number.toLongLong());
+            else
+                obj = PyFloat_FromDouble(value.toDouble());
+
+            break;
+        }
+
+    case QJsonValue::String:
+        obj = qpycore_PyObject_FromQString(value.toString());
+        break;
+
+    case QJsonValue::Array:
+        {
+            const QJsonArray array = value.toArray();
+
+            obj = PyList_New(array.size());
+
+            if (!obj)
+                break;
+
+            for (qsizetype i = 0; i < array.size(); ++i)
+            {
+                PyObject *el_obj = from_qjsonvalue(array.at(i), keys);
+
+                if (!el_obj)
+                {
+                    Py_DECREF(obj);
+                    return 0;
+                }
+
+                PyList_SetItem(obj, i, el_obj);
+            }
+
+            break;
+        }
+
+    case QJsonValue::Object:
+        {
+            const QJsonObject object = value.toObject();
+
+            obj = PyDict_New();
+
+            if (!obj)
+                break;
+
+            QJsonObject::const_iterator it = object.constBegin();
+
+            while (it != object.constEnd())
+            {
+                PyObject *key_obj = keys.get(it.key());
+
+                if (!key_obj)
+                {
+                    Py_DECREF(obj);
+                    return 0;
+                }
+
+                PyObject *el_obj = from_qjsonvalue(it.value(), keys);
+
+                if (!el_obj)
+                {
+                    Py_DECREF(key_obj);
+                    Py_DECREF(obj);
+                    return 0;
+                }
+
+                int rc = PyDict_SetItem(obj, key_obj, el_obj);
+
+                Py_DECREF(el_obj);
+                Py_DECREF(key_obj);
+
+                if (rc < 0)
+                {
+                    Py_DECREF(obj);
+                    return 0;
+                }
+
+                ++it;
+            }
+
+            break;
+        }
+
+    default:
+        Py_INCREF(Py_None);
+        obj = Py_None;
+    }
+
+    return obj;
+}
+
+
+// Convert a native Python object (which may be a container of any supported
+// type) to a QJsonValue.
+static bool as_native_qjsonvalue(PyObject *obj, QJsonValue &value)
+{
+    // Note that bool must be checked before int.
+    if (PyBool_Check(obj))
+    {
+        value = QJsonValue(obj == Py_True);
+        return true;
+    }
+
+    if (PyLong_Check(obj))
+    {
+        int overflow;
+        long long ll = PyLong_AsLongLongAndOverflow(obj, &overflow);
+
+        if (overflow)
+        {
+            // Values that are too big are stored as doubles.
+            double d = PyLong_AsDouble(obj);
+
+            if (PyErr_Occurred())
+                return false;
+
+            value = QJsonValue(d);
+        }
+        else
+        {
+            if (PyErr_Occurred())
+                return false;
+
+            value = QJsonValue(static_cast<qint64>(ll));
+        }
+
+        return true;
+    }
+
+    if (PyFloat_Check(obj))
+    {
+        value = QJsonValue(PyFloat_AsDouble(obj));
+        return true;
+    }
+
+    if (PyUnicode_Check(obj))
+    {
+        value = QJsonValue(qpycore_PyObject_AsQString(obj));
+        return true;
+    }
+
+    // Containers may be self-referential or very deeply nested.
+    if (Py_EnterRecursiveCall(" while converting to a QJsonValue"))
+        return false;
+
+    bool ok = as_native_container(obj, value);
+
+    Py_LeaveRecursiveCall();
+
+    return ok;
+}
+
+
+// Convert a native Python dict, list or tuple to a QJsonValue.
+static bool as_native_container(PyObject *obj, QJsonValue &value)
+{
+    if (PyDict_Check(obj))
+    {
+        QJsonObject object;
+
+        Py_ssize_t pos = 0;
+        PyObject *key_obj, *el_obj;
+
+        while (PyDict_Next(obj, &pos, &key_obj, &el_obj))
+        {
+            if (!PyUnicode_Check(key_obj))
+            {
+                PyErr_Format(PyExc_TypeError,
+                        "a key has type '%s' but 'str' is expected",
+                        sipPyTypeName(Py_TYPE(key_obj)));
+
+                return false;
+            }
+
+            QJsonValue el;
+
+            if (!qpycore_PyObject_AsQJsonValue(el_obj, el))
+                return false;
+
+            object.insert(qpycore_PyObject_AsQString(key_obj), el);
+        }
+
+        value = QJsonValue(object);
+        return true;
+    }
+
+    // Only lists and tuples are left.
+    bool is_list = PyList_Check(obj);
+    Py_ssize_t size = (is_list ? PyList_Size(obj) : PyTuple_Size(obj));
+
+    QJsonArray array;
+
+    for (Py_ssize_t i = 0; i < size; ++i)
+    {
+        PyObject *el_obj = (is_list ? PyList_GetItem(obj, i) :
+                PyTuple_GetItem(obj, i));
+
+        if (!el_obj)
+            return false;
+
+        QJsonValue el;
+
+        if (!qpycore_PyObject_AsQJsonValue(el_obj, el))
+            return false;
+
+        array.append(el);
+    }
+
+    value = QJsonValue(array);
+    return true;
+}
+
+
+// Return true if a Python object is of a native type that is converted
+// directly.
+static bool is_native(PyObject *obj)
+{
+    return (PyBool_Check(obj) || PyLong_Check(obj) || PyFloat_Check(obj) ||
+            PyUnicode_Check(obj) || PyDict_Check(obj) || PyList_Check(obj) ||
+            PyTuple_Check(obj));
+}
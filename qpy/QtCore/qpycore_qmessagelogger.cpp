@@ -25,74 +25,73 @@
 #include "sipAPIQtCore.h"
 
 
-// Return the current Python context.  This should be called with the GIL.
-int qpycore_current_context(const char **file, const char **function)
-{
-    static PyObject *currentframe = 0;
-    static PyObject *getframeinfo = 0;
-    static PyObject *saved_file = 0;
-    static PyObject *saved_function = 0;
+// The maximum number of code objects whose encoded names are cached.
+#define MAX_CACHED_CONTEXTS 512
 
-    PyObject *frame, *info, *file_obj, *linenr_obj, *function_obj;
-    int linenr;
 
-    frame = info = NULL;
+// Forward declarations.
+static bool init_context();
+static PyObject *encode_context(PyObject *code);
+static PyObject *cached_context(PyObject *code);
 
-    // Make sure we have what we need from the inspect module.
-    if (!currentframe || !getframeinfo)
-    {
-        PyObject *inspect = PyImport_ImportModule("inspect");
 
-        if (inspect)
-        {
-            if (!currentframe)
-                currentframe = PyObject_GetAttrString(inspect, "currentframe");
+// The cached objects used to get the context.
+static PyObject *getframe = 0;
+static PyObject *context_cache = 0;
+static PyObject *f_code_str = 0;
+static PyObject *f_lineno_str = 0;
+static PyObject *co_filename_str = 0;
+static PyObject *co_name_str = 0;
 
-            if (!getframeinfo)
-                getframeinfo = PyObject_GetAttrString(inspect, "getframeinfo");
 
-            Py_DECREF(inspect);
-        }
+// Return the current Python context.  The frame is inspected directly so that
+// (unlike inspect.getframeinfo()) no source is read, and the encoded file and
+// function names are cached for each code object.  This should be called with
+// the GIL.
+int qpycore_current_context(const char **file, const char **function)
+{
+    static PyObject *saved_context = 0;
 
-        if (!currentframe || !getframeinfo)
-            goto py_error;
-    }
+    PyObject *frame, *code, *linenr_obj, *context;
+    int linenr;
 
-    // Get the current frame.
-    if ((frame = PyObject_CallFunctionObjArgs(currentframe, NULL)) == NULL)
-        goto py_error;
+    frame = code = linenr_obj = NULL;
 
-    // Get the frame details.
-    if ((info = PyObject_CallFunctionObjArgs(getframeinfo, frame, NULL)) == NULL)
-        goto py_error;;
+    if (!init_context())
+        goto py_error;
 
-    if ((file_obj = PyTuple_GetItem(info, 0)) == NULL)
+    // Get the frame of the caller.  There is no frame for the call from C++.
+    if ((frame = PyObject_CallFunctionObjArgs(getframe, NULL)) == NULL)
         goto py_error;
 
-    if ((linenr_obj = PyTuple_GetItem(info, 1)) == NULL)
+    if ((code = PyObject_GetAttr(frame, f_code_str)) == NULL)
         goto py_error;
 
-    if ((function_obj = PyTuple_GetItem(info, 2)) == NULL)
+    if ((linenr_obj = PyObject_GetAttr(frame, f_lineno_str)) == NULL)
         goto py_error;
 
-    Py_XDECREF(saved_file);
-    saved_file = PyUnicode_AsEncodedString(file_obj, "latin_1", "ignore");
-    *file = PyBytes_AsString(saved_file);
+    // The line number may be None and we ignore any overflow exception.
+    linenr = (linenr_obj != Py_None ? sipLong_AsInt(linenr_obj) : 0);
+
+    if ((context = cached_context(code)) == NULL)
+        goto py_error;
 
-    // Ignore any overflow exception.
-    linenr = sipLong_AsInt(linenr_obj);
+    // Keep the names alive while the message is being logged.
+    Py_XDECREF(saved_context);
+    saved_context = context;
 
-    Py_XDECREF(saved_function);
-    saved_function = PyUnicode_AsEncodedString(function_obj, "latin_1", "ignore");
-    *function = PyBytes_AsString(saved_function);
+    *file = PyBytes_AsString(PyTuple_GetItem(context, 0));
+    *function = PyBytes_AsString(PyTuple_GetItem(context, 1));
 
-    Py_DECREF(info);
+    Py_DECREF(linenr_obj);
+    Py_DECREF(code);
     Py_DECREF(frame);
 
     return linenr;
 
 py_error:
-    Py_XDECREF(info);
+    Py_XDECREF(linenr_obj);
+    Py_XDECREF(code);
     Py_XDECREF(frame);
 
     pyqt6_err_print();
@@ -100,3 +99,125 @@ py_error:
     *file = *function = "";
     return 0;
 }
+
+
+// Make sure we have the objects needed to get the context.
+static bool init_context()
+{
+    if (getframe)
+        return true;
+
+    if (!context_cache)
+        context_cache = PyDict_New();
+
+    if (!f_code_str)
+        f_code_str = PyUnicode_InternFromString("f_code");
+
+    if (!f_lineno_str)
+        f_lineno_str = PyUnicode_InternFromString("f_lineno");
+
+    if (!co_filename_str)
+        co_filename_str = PyUnicode_InternFromString("co_filename");
+
+    if (!co_name_str)
+        co_name_str = PyUnicode_InternFromString("co_name");
+
+    if (!context_cache || !f_code_str || !f_lineno_str || !co_filename_str ||
+            !co_name_str)
+        return false;
+
+    PyObject *sys = PyImport_ImportModule("sys");
+
+    if (!sys)
+        return false;
+
+    getframe = PyObject_GetAttrString(sys, "_getframe");
+
+    Py_DECREF(sys);
+
+    return (getframe != NULL);
+}
+
+
+// Return a new reference to the cached context of a code object, creating it
+// if necessary.  The cache is keyed by the identity of the code object rather
+// than by equality, which ignores the file name and is expensive to compute.
+// Each entry holds a reference to the code object so that its address cannot
+// be reused while it is cached.
+static PyObject *cached_context(PyObject *code)
+{
+    PyObject *key, *context;
+
+    if ((key = PyLong_FromVoidPtr(code)) == NULL)
+        return NULL;
+
+    if ((context = PyDict_GetItem(context_cache, key)) != NULL)
+    {
+        Py_INCREF(context);
+        Py_DECREF(key);
+
+        return context;
+    }
+
+    if ((context = encode_context(code)) == NULL)
+    {
+        Py_DECREF(key);
+        return NULL;
+    }
+
+    // Code objects may be created dynamically so limit the size of the cache.
+    if (PyDict_Size(context_cache) >= MAX_CACHED_CONTEXTS)
+        PyDict_Clear(context_cache);
+
+    int rc = PyDict_SetItem(context_cache, key, context);
+
+    Py_DECREF(key);
+
+    if (rc < 0)
+    {
+        Py_DECREF(context);
+        return NULL;
+    }
+
+    return context;
+}
+
+
+// Return a tuple of the Latin-1 encoded file and function names of a code
+// object and the code object itself.
+static PyObject *encode_context(PyObject *code)
+{
+    PyObject *file_obj, *function_obj, *file_bytes, *function_bytes, *context;
+
+    if ((file_obj = PyObject_GetAttr(code, co_filename_str)) == NULL)
+        return NULL;
+
+    file_bytes = PyUnicode_AsEncodedString(file_obj, "latin_1", "ignore");
+    Py_DECREF(file_obj);
+
+    if (file_bytes == NULL)
+        return NULL;
+
+    if ((function_obj = PyObject_GetAttr(code, co_name_str)) == NULL)
+    {
+        Py_DECREF(file_bytes);
+        return NULL;
+    }
+
+    function_bytes = PyUnicode_AsEncodedString(function_obj, "latin_1",
+            "ignore");
+    Py_DECREF(function_obj);
+
+    if (function_bytes == NULL)
+    {
+        Py_DECREF(file_bytes);
+        return NULL;
+    }
+
+    context = PyTuple_Pack(3, file_bytes, function_bytes, code);
+
+    Py_DECREF(file_bytes);
+    Py_DECREF(function_bytes);
+
+    return context;
+}
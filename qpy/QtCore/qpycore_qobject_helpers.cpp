@@ -214,7 +214,7 @@ bool qpycore_qobject_qt_metacast(sipSimpleWrapper *pySelf,
 
     bool is_py_class = false;
 
-    SIP_BLOCK_THREADS
+    QPYCORE_BLOCK_THREADS("qpycore_qobject_qt_metacast()")
 
     PyTypeObject *base_pytype = sipTypeAsPyTypeObject(base);
 
@@ -264,7 +264,7 @@ bool qpycore_qobject_qt_metacast(sipSimpleWrapper *pySelf,
         Py_DECREF(mro);
     }
 
-    SIP_UNBLOCK_THREADS
+    QPYCORE_UNBLOCK_THREADS
 
     return is_py_class;
 }
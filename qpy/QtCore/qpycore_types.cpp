@@ -26,6 +26,7 @@
 #include <QMetaObject>
 #include <QMetaType>
 #include <QPair>
+#include <QSet>
 
 #include "qpycore_chimera.h"
 #include "qpycore_classinfo.h"
@@ -50,11 +51,11 @@ typedef QPair<PyObject *, PyObject *> PropertyData;
 static int trawl_hierarchy(PyTypeObject *pytype, qpycore_metaobject *qo,
         QMetaObjectBuilder &builder, QList<EnumFlag> &penums,
         QList<const qpycore_pyqtSignal *> &psigs,
-        QMap<uint, PropertyData> &pprops);
+        QMap<uint, PropertyData> &pprops, QSet<QByteArray> &slot_sigs);
 static int trawl_type(PyTypeObject *pytype, qpycore_metaobject *qo,
         QMetaObjectBuilder &builder, QList<EnumFlag> &penums,
         QList<const qpycore_pyqtSignal *> &psigs,
-        QMap<uint, PropertyData> &pprops);
+        QMap<uint, PropertyData> &pprops, QSet<QByteArray> &slot_sigs);
 static const QMetaObject *get_scope_qmetaobject(const Chimera *ct);
 
 
@@ -95,10 +96,11 @@ const qpycore_metaobject *qpycore_get_dynamic_metaobject(sipWrapperType *wt)
     QList<EnumFlag> penums;
     QList<const qpycore_pyqtSignal *> psigs;
     QMap<uint, PropertyData> pprops;
+    QSet<QByteArray> slot_sigs;
 
     qo = new qpycore_metaobject;
 
-    if (trawl_hierarchy(pytype, qo, builder, penums, psigs, pprops) < 0)
+    if (trawl_hierarchy(pytype, qo, builder, penums, psigs, pprops, slot_sigs) < 0)
         return 0;
 
     qo->nr_signals = psigs.count();
@@ -332,9 +334,9 @@ const qpycore_metaobject *qpycore_get_dynamic_metaobject(sipWrapperType *wt)
 static int trawl_hierarchy(PyTypeObject *pytype, qpycore_metaobject *qo,
         QMetaObjectBuilder &builder, QList<EnumFlag> &penums,
         QList<const qpycore_pyqtSignal *> &psigs,
-        QMap<uint, PropertyData> &pprops)
+        QMap<uint, PropertyData> &pprops, QSet<QByteArray> &slot_sigs)
 {
-    if (trawl_type(pytype, qo, builder, penums, psigs, pprops) < 0)
+    if (trawl_type(pytype, qo, builder, penums, psigs, pprops, slot_sigs) < 0)
         return -1;
 
     PyObject *tp_bases;
@@ -357,7 +359,8 @@ static int trawl_hierarchy(PyTypeObject *pytype, qpycore_metaobject *qo,
         if (PyType_IsSubtype(sup, sipTypeAsPyTypeObject(sipType_QObject)))
             continue;
 
-        if (trawl_hierarchy(sup, qo, builder, penums, psigs, pprops) < 0)
+        if (trawl_hierarchy(sup, qo, builder, penums, psigs, pprops,
+                slot_sigs) < 0)
             return -1;
     }
 
@@ -369,7 +372,7 @@ static int trawl_hierarchy(PyTypeObject *pytype, qpycore_metaobject *qo,
 static int trawl_type(PyTypeObject *pytype, qpycore_metaobject *qo,
         QMetaObjectBuilder &builder, QList<EnumFlag> &penums,
         QList<const qpycore_pyqtSignal *> &psigs,
-        QMap<uint, PropertyData> &pprops)
+        QMap<uint, PropertyData> &pprops, QSet<QByteArray> &slot_sigs)
 {
     int rc = 0;
     Py_ssize_t pos = 0;
@@ -388,105 +391,98 @@ static int trawl_type(PyTypeObject *pytype, qpycore_metaobject *qo,
             continue;
         }
 
-        // See if it is a slot, ie. it has been decorated with pyqtSlot().
-        PyObject *sig_obj = PyObject_GetAttr(value,
-                qpycore_dunder_pyqtsignature);
-
-        if (sig_obj)
+        // Properties and signals cannot also be slots so check for them
+        // first and avoid the cost of a failed attribute lookup.
+        if (PyObject_TypeCheck(value, qpycore_pyqtProperty_TypeObject))
         {
-            // Make sure it is a list and not some legitimate attribute that
-            // happens to use our special name.
-            if (PyList_Check(sig_obj))
+            // It is a property.
+
+            // Make sure the key is an ASCII string.
+            if (!sipString_AsASCIIString(&key))
             {
-                for (Py_ssize_t i = 0; i < PyList_Size(sig_obj); ++i)
-                {
-                    // Set up the skeleton slot.
-                    PyObject *decoration = PyList_GetItem(sig_obj, i);
-                    Chimera::Signature *slot_signature = Chimera::Signature::fromPyObject(decoration);
-
-                    // Check if a slot of the same signature has already been
-                    // defined.  This typically happens with sub-classed
-                    // mixins.
-                    bool overridden = false;
-
-                    for (int i = 0; i < qo->pslots.size(); ++i)
-                        if (qo->pslots.at(i)->slotSignature()->signature == slot_signature->signature)
-                        {
-                            overridden = true;
-                            break;
-                        }
-
-                    if (!overridden)
-                        qo->pslots.append(
-                                new PyQtSlot(value, true, slot_signature));
-                }
+                rc = -1;
+                break;
             }
 
-            Py_DECREF(sig_obj);
+            Py_INCREF(value);
+
+            qpycore_pyqtProperty *pp = (qpycore_pyqtProperty *)value;
+
+            pprops.insert(pp->pyqtprop_sequence, PropertyData(key, value));
+
+            // See if the property has a scope.  If so, collect all
+            // QMetaObject pointers that are not in the super-class hierarchy.
+            const QMetaObject *mo = get_scope_qmetaobject(pp->pyqtprop_parsed_type);
+
+            if (mo)
+                builder.addRelatedMetaObject(mo);
+
+            continue;
         }
-        else
+
+        if (PyObject_TypeCheck(value, qpycore_pyqtSignal_TypeObject))
         {
-            PyErr_Clear();
+            // It is a signal.
 
-            // Make sure the key is an ASCII string.  Delay the error checking
-            // until we know we actually need it.
+            // Make sure the key is an ASCII string.
             const char *ascii_key = sipString_AsASCIIString(&key);
 
-            // See if the value is of interest.
-            if (PyObject_TypeCheck(value, qpycore_pyqtProperty_TypeObject))
+            if (!ascii_key)
             {
-                // It is a property.
+                rc = -1;
+                break;
+            }
 
-                if (!ascii_key)
-                {
-                    rc = -1;
-                    break;
-                }
+            qpycore_pyqtSignal *ps = (qpycore_pyqtSignal *)value;
 
-                Py_INCREF(value);
+            // Make sure the signal has a name.
+            qpycore_set_signal_name(ps, sipPyTypeName(pytype), ascii_key);
 
-                qpycore_pyqtProperty *pp = (qpycore_pyqtProperty *)value;
+            // Add all the overloads.
+            do
+            {
+                psigs.append(ps);
+                ps = ps->next;
+            }
+            while (ps);
 
-                pprops.insert(pp->pyqtprop_sequence, PropertyData(key, value));
+            Py_DECREF(key);
 
-                // See if the property has a scope.  If so, collect all
-                // QMetaObject pointers that are not in the super-class
-                // hierarchy.
-                const QMetaObject *mo = get_scope_qmetaobject(pp->pyqtprop_parsed_type);
+            continue;
+        }
 
-                if (mo)
-                    builder.addRelatedMetaObject(mo);
-            }
-            else if (PyObject_TypeCheck(value, qpycore_pyqtSignal_TypeObject))
-            {
-                // It is a signal.
+        // See if it is a slot, ie. it has been decorated with pyqtSlot().
+        PyObject *sig_obj = PyObject_GetAttr(value,
+                qpycore_dunder_pyqtsignature);
 
-                if (!ascii_key)
-                {
-                    rc = -1;
-                    break;
-                }
+        if (!sig_obj)
+        {
+            PyErr_Clear();
+            continue;
+        }
 
-                qpycore_pyqtSignal *ps = (qpycore_pyqtSignal *)value;
+        // Make sure it is a list and not some legitimate attribute that
+        // happens to use our special name.
+        if (PyList_Check(sig_obj))
+        {
+            for (Py_ssize_t i = 0; i < PyList_Size(sig_obj); ++i)
+            {
+                // Set up the skeleton slot.
+                PyObject *decoration = PyList_GetItem(sig_obj, i);
+                Chimera::Signature *slot_signature = Chimera::Signature::fromPyObject(decoration);
 
-                // Make sure the signal has a name.
-                qpycore_set_signal_name(ps, sipPyTypeName(pytype), ascii_key);
+                // Ignore a slot if one of the same signature has already been
+                // defined.  This typically happens with sub-classed mixins.
+                if (slot_sigs.contains(slot_signature->signature))
+                    continue;
 
-                // Add all the overloads.
-                do
-                {
-                    psigs.append(ps);
-                    ps = ps->next;
-                }
-                while (ps);
+                slot_sigs.insert(slot_signature->signature);
 
-                Py_DECREF(key);
-            }
-            else
-            {
-                PyErr_Clear();
+                qo->pslots.append(new PyQtSlot(value, true, slot_signature));
             }
         }
+
+        Py_DECREF(sig_obj);
     }
 
     Py_DECREF(dict);
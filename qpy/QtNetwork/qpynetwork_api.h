@@ -0,0 +1,44 @@
+// This defines the API provided by this library.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYNETWORK_API_H
+#define _QPYNETWORK_API_H
+
+
+#include <Python.h>
+
+#include <QString>
+
+
+class QIODevice;
+class QNetworkReply;
+
+
+// Support for the QNetworkReply body sinks.
+void qpynetwork_set_sink(QNetworkReply *reply, QIODevice *device);
+void qpynetwork_set_sink(QNetworkReply *reply, int fd);
+bool qpynetwork_set_sink(QNetworkReply *reply, PyObject *buffer);
+void qpynetwork_clear_sink(QNetworkReply *reply);
+PyObject *qpynetwork_sink_statistics(QNetworkReply *reply);
+QString qpynetwork_sink_error_string(QNetworkReply *reply);
+
+
+#endif
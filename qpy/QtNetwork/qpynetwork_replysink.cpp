@@ -0,0 +1,456 @@
+// This is the implementation of the PyQtReplySink class and its API.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#include <Python.h>
+
+#include <QHash>
+#include <QIODevice>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QNetworkReply>
+#include <QSocketNotifier>
+
+#include <errno.h>
+#include <string.h>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "qpynetwork_api.h"
+#include "qpynetwork_replysink.h"
+
+
+// The sink of each reply.  Replies may be in different threads and a sink is
+// destroyed without the GIL so access is protected by a mutex.
+static QHash<QNetworkReply *, PyQtReplySink *> reply_sinks;
+static QMutex reply_sinks_mutex;
+
+
+// Create the sink for a reply.
+PyQtReplySink::PyQtReplySink(QNetworkReply *reply) : QObject(reply),
+        _reply(reply), _kind(NoSink), _fd(-1), _buffer_pos(0),
+        _notifier(nullptr), _bytes(0), _chunks(0), _stalls(0), _errors(0)
+{
+    connect(reply, &QIODevice::readyRead, this, &PyQtReplySink::drain);
+    connect(reply, &QNetworkReply::finished, this, &PyQtReplySink::drain);
+}
+
+
+// Destroy the sink.
+PyQtReplySink::~PyQtReplySink()
+{
+    detach();
+    releaseSink();
+}
+
+
+// Return the existing sink of a reply.
+PyQtReplySink *PyQtReplySink::find(QNetworkReply *reply)
+{
+    QMutexLocker locker(&reply_sinks_mutex);
+
+    return reply_sinks.value(reply);
+}
+
+
+// Return the sink of a reply, creating it if necessary.
+PyQtReplySink *PyQtReplySink::findOrCreate(QNetworkReply *reply)
+{
+    QMutexLocker locker(&reply_sinks_mutex);
+
+    PyQtReplySink *sink = reply_sinks.value(reply);
+
+    if (!sink)
+    {
+        sink = new PyQtReplySink(reply);
+        reply_sinks.insert(reply, sink);
+    }
+
+    return sink;
+}
+
+
+// Remove the sink from its reply.  It is deleted later as it may be removed by
+// Python code called while it is delivering data.
+void PyQtReplySink::remove()
+{
+    detach();
+    releaseSink();
+
+    disconnect(_reply, nullptr, this, nullptr);
+
+    deleteLater();
+}
+
+
+// Forget the sink as the one of its reply.
+void PyQtReplySink::detach()
+{
+    QMutexLocker locker(&reply_sinks_mutex);
+
+    if (reply_sinks.value(_reply) == this)
+        reply_sinks.remove(_reply);
+}
+
+
+// Write the body to a QIODevice.
+void PyQtReplySink::setSink(QIODevice *device)
+{
+    releaseSink();
+    _error_string.clear();
+
+    _kind = DeviceSink;
+    _device = device;
+
+    drain();
+}
+
+
+// Write the body to a file descriptor.
+void PyQtReplySink::setSink(int fd)
+{
+    releaseSink();
+    _error_string.clear();
+
+    _kind = DescriptorSink;
+    _fd = fd;
+
+    drain();
+}
+
+
+// Copy the body into a writable buffer.  When the buffer is full the rest of
+// the body is left in the reply until another buffer is set.  This is called
+// with the GIL.
+void PyQtReplySink::setSink(const sipBufferInfoDef &bi)
+{
+    releaseSink();
+    _error_string.clear();
+
+    _kind = BufferSink;
+    _buffer = bi;
+    _buffer_pos = 0;
+
+    drain();
+}
+
+
+// Return a tuple of the number of bytes and chunks delivered, the elapsed
+// time in seconds, the throughput in bytes per second, the number of times
+// the sink couldn't accept data, the number of write errors, the number of
+// bytes written to the current buffer and the number of bytes waiting in the
+// reply.
+PyObject *PyQtReplySink::statistics() const
+{
+    double elapsed = _timer.isValid() ? _timer.nsecsElapsed() / 1.0e9 : 0.0;
+    double throughput = (elapsed > 0.0) ? _bytes / elapsed : 0.0;
+
+    return Py_BuildValue("(LLddLLLL)", (long long)_bytes, (long long)_chunks,
+            elapsed, throughput, (long long)_stalls, (long long)_errors,
+            (long long)(_kind == BufferSink ? _buffer_pos : 0),
+            (long long)_reply->bytesAvailable());
+}
+
+
+// Deliver all the available data to the sink.  This doesn't need the GIL.
+void PyQtReplySink::drain()
+{
+    if (_kind == NoSink)
+        return;
+
+    if (!_timer.isValid())
+        _timer.start();
+
+    if (_kind == BufferSink)
+    {
+        char *data = reinterpret_cast<char *>(_buffer.bi_buf);
+
+        while (_reply->bytesAvailable() > 0)
+        {
+            qint64 space = _buffer.bi_len - _buffer_pos;
+
+            if (space <= 0)
+            {
+                // Apply back pressure until a new buffer is set.
+                ++_stalls;
+                break;
+            }
+
+            qint64 len = _reply->read(data + _buffer_pos, space);
+
+            if (len <= 0)
+                break;
+
+            _buffer_pos += len;
+            _bytes += len;
+            ++_chunks;
+        }
+    }
+    else
+    {
+        // Wait until any data that couldn't be written has been written.
+        if (!_pending.isEmpty())
+            return;
+
+        Kind kind = _kind;
+
+        // A device may call Python code that changes or removes the sink.
+        while (_kind == kind && _reply->bytesAvailable() > 0)
+        {
+            // This doesn't copy the data if it is held in a single block.
+            QByteArray chunk = _reply->readAll();
+
+            if (chunk.isEmpty())
+                break;
+
+            if (!write(chunk.constData(), chunk.size()))
+            {
+                fail();
+                break;
+            }
+
+            _bytes += chunk.size();
+            ++_chunks;
+
+            if (!_pending.isEmpty())
+                break;
+        }
+    }
+}
+
+
+// Write some data to the device or file descriptor.  If a non-blocking file
+// descriptor isn't ready then the rest of the data is kept until it is.  If
+// the sink is changed or removed while writing then the rest of the data is
+// discarded.  Return false if there was an error.
+bool PyQtReplySink::write(const char *data, qint64 len)
+{
+    Kind kind = _kind;
+
+    while (len > 0)
+    {
+        if (_kind != kind)
+            return true;
+
+        qint64 written;
+
+        if (_kind == DeviceSink)
+        {
+            if (!_device)
+            {
+                _error_string = QStringLiteral(
+                        "the sink device has been destroyed");
+                return false;
+            }
+
+            written = _device->write(data, len);
+
+            if (written < 0)
+            {
+                _error_string = _device->errorString();
+                return false;
+            }
+        }
+        else
+        {
+#if defined(Q_OS_WIN)
+            unsigned block = (unsigned)qMin(len, qint64(0x40000000));
+
+            written = ::_write(_fd, data, block);
+#else
+            written = ::write(_fd, data, len);
+#endif
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+#if !defined(Q_OS_WIN)
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    ++_stalls;
+                    _pending = QByteArray(data, len);
+
+                    if (!_notifier)
+                    {
+                        _notifier = new QSocketNotifier(_fd,
+                                QSocketNotifier::Write, this);
+
+                        connect(_notifier, &QSocketNotifier::activated, this,
+                                &PyQtReplySink::writable);
+                    }
+
+                    _notifier->setEnabled(true);
+
+                    return true;
+                }
+#endif
+
+                _error_string = QString::fromLocal8Bit(strerror(errno));
+                return false;
+            }
+        }
+
+        // A short write means the sink is applying back pressure.
+        if (written < len)
+            ++_stalls;
+
+        data += written;
+        len -= written;
+    }
+
+    return true;
+}
+
+
+// Write any data that was kept because the file descriptor wasn't ready and
+// then resume delivery.
+void PyQtReplySink::writable()
+{
+    _notifier->setEnabled(false);
+
+    QByteArray pending = _pending;
+    _pending.clear();
+
+    if (!write(pending.constData(), pending.size()))
+        fail();
+    else if (_pending.isEmpty())
+        drain();
+}
+
+
+// Handle an error writing to the sink.  The reply is aborted so that the
+// application sees the failure through the reply's own error handling.
+void PyQtReplySink::fail()
+{
+    ++_errors;
+
+    releaseSink();
+
+    _reply->abort();
+}
+
+
+// Release the current sink.  Any data that hasn't been written is discarded.
+void PyQtReplySink::releaseSink()
+{
+    _pending.clear();
+
+    // This may be called from the notifier's own signal.
+    if (_notifier)
+    {
+        _notifier->deleteLater();
+        _notifier = nullptr;
+    }
+
+    if (_kind == BufferSink)
+    {
+        // Qt can still be tidying up after Python has gone so make sure that
+        // it hasn't.
+        if (Py_IsInitialized())
+        {
+            SIP_BLOCK_THREADS
+            sipReleaseBufferInfo(&_buffer);
+            SIP_UNBLOCK_THREADS
+        }
+    }
+
+    _kind = NoSink;
+}
+
+
+// Set a QIODevice as the sink of a reply.
+void qpynetwork_set_sink(QNetworkReply *reply, QIODevice *device)
+{
+    PyQtReplySink::findOrCreate(reply)->setSink(device);
+}
+
+
+// Set a file descriptor as the sink of a reply.
+void qpynetwork_set_sink(QNetworkReply *reply, int fd)
+{
+    PyQtReplySink::findOrCreate(reply)->setSink(fd);
+}
+
+
+// Set a writable buffer as the sink of a reply.  Return false and raise an
+// exception if there was an error.
+bool qpynetwork_set_sink(QNetworkReply *reply, PyObject *buffer)
+{
+    sipBufferInfoDef bi;
+
+    if (sipGetBufferInfo(buffer, &bi) <= 0)
+        return false;
+
+    if (bi.bi_readonly)
+    {
+        PyErr_SetString(PyExc_TypeError, "the buffer is read-only");
+        sipReleaseBufferInfo(&bi);
+
+        return false;
+    }
+
+    PyQtReplySink::findOrCreate(reply)->setSink(bi);
+
+    return true;
+}
+
+
+// Remove any sink from a reply.
+void qpynetwork_clear_sink(QNetworkReply *reply)
+{
+    PyQtReplySink *sink = PyQtReplySink::find(reply);
+
+    if (sink)
+        sink->remove();
+}
+
+
+// Return the statistics of the sink of a reply or None if there is no sink.
+PyObject *qpynetwork_sink_statistics(QNetworkReply *reply)
+{
+    PyQtReplySink *sink = PyQtReplySink::find(reply);
+
+    if (!sink)
+    {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
+    return sink->statistics();
+}
+
+
+// Return the description of the last error of the sink of a reply.  An empty
+// string is returned if there was no error or there is no sink.
+QString qpynetwork_sink_error_string(QNetworkReply *reply)
+{
+    PyQtReplySink *sink = PyQtReplySink::find(reply);
+
+    if (!sink)
+        return QString();
+
+    return sink->errorString();
+}
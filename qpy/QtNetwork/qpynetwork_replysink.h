@@ -0,0 +1,100 @@
+// This is the declaration of the PyQtReplySink class.
+//
+// Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
+// 
+// This file is part of PyQt6.
+// 
+// This file may be used under the terms of the GNU General Public License
+// version 3.0 as published by the Free Software Foundation and appearing in
+// the file LICENSE included in the packaging of this file.  Please review the
+// following information to ensure the GNU General Public License version 3.0
+// requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+// 
+// If you do not wish to use this file under the terms of the GPL version 3.0
+// then you may purchase a commercial license.  For more information contact
+// info@riverbankcomputing.com.
+// 
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+
+
+
+#ifndef _QPYNETWORK_REPLYSINK_H
+#define _QPYNETWORK_REPLYSINK_H
+
+
+#include <Python.h>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+
+#include "sipAPIQtNetwork.h"
+
+
+class QIODevice;
+class QNetworkReply;
+class QSocketNotifier;
+
+
+// This class drains the body of a network reply into a sink as it arrives
+// without creating any Python objects.  The sink is a QIODevice, a file
+// descriptor or a writable Python buffer.  It is a child of the reply.  If
+// the sink fails then the reply is aborted.
+class PyQtReplySink : public QObject
+{
+public:
+    PyQtReplySink(QNetworkReply *reply);
+    ~PyQtReplySink();
+
+    static PyQtReplySink *find(QNetworkReply *reply);
+    static PyQtReplySink *findOrCreate(QNetworkReply *reply);
+
+    void remove();
+
+    void setSink(QIODevice *device);
+    void setSink(int fd);
+    void setSink(const sipBufferInfoDef &bi);
+
+    PyObject *statistics() const;
+    QString errorString() const {return _error_string;}
+
+private:
+    enum Kind {
+        NoSink,
+        DeviceSink,
+        DescriptorSink,
+        BufferSink
+    };
+
+    QNetworkReply *_reply;
+    Kind _kind;
+    QPointer<QIODevice> _device;
+    int _fd;
+    sipBufferInfoDef _buffer;
+    qint64 _buffer_pos;
+    QByteArray _pending;
+    QSocketNotifier *_notifier;
+    QString _error_string;
+
+    // The statistics.
+    QElapsedTimer _timer;
+    qint64 _bytes;
+    qint64 _chunks;
+    qint64 _stalls;
+    qint64 _errors;
+
+    void drain();
+    bool write(const char *data, qint64 len);
+    void writable();
+    void fail();
+    void releaseSink();
+    void detach();
+
+    PyQtReplySink(const PyQtReplySink &);
+};
+
+
+#endif
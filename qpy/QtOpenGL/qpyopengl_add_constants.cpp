@@ -1,6 +1,6 @@
 /*
- * This implements a function to populate a Python object with the OpenGL
- * constants.  This file is automatically generated.
+ * This implements a function to look up the value of an OpenGL constant.
+ * The tables in this file are automatically generated.
  *
  * Copyright (c) 2025 Riverbank Computing Limited <info@riverbankcomputing.com>
  * 
@@ -5066,10 +5066,10 @@ static OpenGLEnum_ull openGLEnums_ull[] = {
 
 
 /*
- * Add the OpenGL constants to a Python object.  Return -1 and raise an
- * exception on error.
+ * Add the constants in the tables to a dict.  Return -1 and raise an exception
+ * on error.
  */
-int qpyopengl_add_constants(PyObject *obj)
+static int add_constants(PyObject *dict)
 {
     int i, rc;
     PyObject *py_value;
@@ -5081,7 +5081,7 @@ int qpyopengl_add_constants(PyObject *obj)
         if (!py_value)
             return -1;
 
-        rc = PyObject_SetAttrString(obj, openGLEnums_i[i].name, py_value);
+        rc = PyDict_SetItemString(dict, openGLEnums_i[i].name, py_value);
         Py_DECREF(py_value);
 
         if (rc < 0)
@@ -5095,7 +5095,7 @@ int qpyopengl_add_constants(PyObject *obj)
         if (!py_value)
             return -1;
 
-        rc = PyObject_SetAttrString(obj, openGLEnums_u[i].name, py_value);
+        rc = PyDict_SetItemString(dict, openGLEnums_u[i].name, py_value);
         Py_DECREF(py_value);
 
         if (rc < 0)
@@ -5109,7 +5109,7 @@ int qpyopengl_add_constants(PyObject *obj)
         if (!py_value)
             return -1;
 
-        rc = PyObject_SetAttrString(obj, openGLEnums_ull[i].name, py_value);
+        rc = PyDict_SetItemString(dict, openGLEnums_ull[i].name, py_value);
         Py_DECREF(py_value);
 
         if (rc < 0)
@@ -5119,3 +5119,36 @@ int qpyopengl_add_constants(PyObject *obj)
     return 0;
 }
 
+
+/*
+ * Return a new reference to the value of an OpenGL constant or 0 if there was
+ * no such constant or an error.  An exception is only raised if there was an
+ * error.  The constants are held in a single dict, shared by all functions
+ * objects, that is created when the first constant is looked up.
+ */
+PyObject *qpyopengl_get_constant(const char *name)
+{
+    static PyObject *constants = 0;
+
+    if (!constants)
+    {
+        PyObject *dict = PyDict_New();
+
+        if (!dict)
+            return 0;
+
+        if (add_constants(dict) < 0)
+        {
+            Py_DECREF(dict);
+            return 0;
+        }
+
+        constants = dict;
+    }
+
+    PyObject *value = PyDict_GetItemString(constants, name);
+
+    Py_XINCREF(value);
+
+    return value;
+}
@@ -24,6 +24,7 @@
 
 #include <Python.h>
 
+#include <QList>
 #include <QtGui/qopengl.h>
 
 #include "sipAPIQtOpenGL.h"
@@ -31,6 +32,12 @@
 
 // Initialisation.
 void qpyopengl_init();
+void qpyopengl_post_init();
+
+// Imports from QtCore.
+typedef PyObject *(*pyqt6_qtopengl_new_array_t)(char, const void *,
+        Py_ssize_t, void **);
+extern pyqt6_qtopengl_new_array_t pyqt6_qtopengl_new_array;
 
 // Support for shader arrays.
 const GLfloat *qpyopengl_attribute_array(PyObject *values, PyObject *shader,
@@ -47,6 +54,9 @@ PyObject *qpyopengl_version_functions(
         const QOpenGLVersionProfile &version_profile, QOpenGLContext *context,
         PyObject *py_context);
 
+// Support for the OpenGL constants.
+PyObject *qpyopengl_get_constant(const char *name);
+
 // Support for the OpenGL bindings.
 const GLvoid *qpyopengl_value_array(sipErrorState *estate, PyObject *values,
         GLenum gl_type, PyObject *bindings);
@@ -66,4 +76,77 @@ PyObject *qpyopengl_from_GLdouble(int *eflag, const GLdouble *array,
         Py_ssize_t len);
 #endif
 
+// Support for the batched glGet*() queries.
+bool qpyopengl_get_pnames(PyObject *pnames, QList<GLenum> &pname_list,
+        QList<GLint> &sizes, QList<GLenum> &queries);
+void *qpyopengl_writable_buffer(PyObject *buffer, char format,
+        Py_ssize_t item_size, Py_ssize_t nr_items, sipBufferInfoDef *bi);
+
+
+// Get the values of a list of parameters using one of the glGet*() functions
+// of a functions object in a single call from Python.  The values are placed
+// in a new memoryview or, if a buffer is given, in that buffer in which case
+// the number of values is returned.
+template<class Funcs, typename T>
+PyObject *qpyopengl_get_values(Funcs *funcs, void (Funcs::*get)(GLenum, T *),
+        char format, PyObject *pnames, PyObject *buffer)
+{
+    QList<GLenum> pname_list;
+    QList<GLint> sizes;
+    QList<GLenum> queries;
+
+    if (!qpyopengl_get_pnames(pnames, pname_list, sizes, queries))
+        return 0;
+
+    Py_ssize_t nr_values = 0;
+
+    for (qsizetype i = 0; i < sizes.size(); ++i)
+    {
+        if (sizes[i] == 0)
+            funcs->glGetIntegerv(queries[i], &sizes[i]);
+
+        if (sizes[i] < 0)
+            sizes[i] = 0;
+
+        nr_values += sizes[i];
+    }
+
+    PyObject *res = 0;
+    sipBufferInfoDef bi;
+    void *data = 0;
+
+    if (buffer)
+    {
+        data = qpyopengl_writable_buffer(buffer, format, sizeof (T),
+                nr_values, &bi);
+
+        if (!data)
+            return 0;
+    }
+    else
+    {
+        res = pyqt6_qtopengl_new_array(format, 0, nr_values * sizeof (T),
+                &data);
+
+        if (!res)
+            return 0;
+    }
+
+    T *values = reinterpret_cast<T *>(data);
+
+    for (qsizetype i = 0; i < pname_list.size(); ++i)
+    {
+        (funcs->*get)(pname_list.at(i), values);
+        values += sizes.at(i);
+    }
+
+    if (buffer)
+    {
+        sipReleaseBufferInfo(&bi);
+        res = PyLong_FromSsize_t(nr_values);
+    }
+
+    return res;
+}
+
 #endif
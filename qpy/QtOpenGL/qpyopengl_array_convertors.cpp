@@ -187,3 +187,68 @@ PyObject *qpyopengl_from_GLdouble(int *eflag, const GLdouble *array,
     return tuple;
 }
 #endif
+
+
+// Get the writable memory of a Python buffer that will hold a number of items
+// of a particular format.  Return 0 and raise an exception if there was an
+// error.
+void *qpyopengl_writable_buffer(PyObject *buffer, char format,
+        Py_ssize_t item_size, Py_ssize_t nr_items, sipBufferInfoDef *bi)
+{
+    int rc = sipGetBufferInfo(buffer, bi);
+
+    if (rc <= 0)
+    {
+        if (rc == 0)
+            PyErr_Format(PyExc_TypeError,
+                    "an object supporting the buffer protocol is expected, "
+                    "not '%s'", sipPyTypeName(Py_TYPE(buffer)));
+
+        return 0;
+    }
+
+    if (bi->bi_readonly)
+    {
+        sipReleaseBufferInfo(bi);
+        PyErr_SetString(PyExc_TypeError, "the buffer is read-only");
+
+        return 0;
+    }
+
+    // Allow a native byte order prefix.  Buffers of bytes may be used for any
+    // type.
+    const char *bi_format = bi->bi_format;
+
+    if (bi_format && (*bi_format == '@' || *bi_format == '='))
+        ++bi_format;
+
+    bool is_bytes = true;
+
+    if (bi_format && bi_format[0] != '\0')
+        is_bytes = (bi_format[1] == '\0' && (bi_format[0] == 'B' ||
+                bi_format[0] == 'b' || bi_format[0] == 'c'));
+
+    if (!is_bytes && (bi_format[0] != format || bi_format[1] != '\0'))
+    {
+        PyErr_Format(PyExc_TypeError,
+                "a buffer of format '%c' is expected, not '%s'", format,
+                bi->bi_format);
+
+        sipReleaseBufferInfo(bi);
+
+        return 0;
+    }
+
+    if (bi->bi_len < nr_items * item_size)
+    {
+        PyErr_Format(PyExc_ValueError,
+                "the buffer must be at least %zd bytes long",
+                nr_items * item_size);
+
+        sipReleaseBufferInfo(bi);
+
+        return 0;
+    }
+
+    return bi->bi_buf;
+}
@@ -18,7 +18,10 @@
 // WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
 
 
+#include <QList>
+
 #include "qpyopengl_api.h"
+#include "qpyopengl_misc.h"
 
 
 // Return the number of values returned for a particular parameter, or the
@@ -172,3 +175,48 @@ GLint qpyopengl_get(GLenum pname, GLenum *query)
 
     return nr_params;
 }
+
+
+// Parse a list or tuple of parameter names for a batched glGet query.  For
+// each name the number of values is appended to a list.  If it is 0 then the
+// corresponding element of the list of queries is the subsequent query needed
+// to obtain it.  Return false and raise an exception if there was an error.
+bool qpyopengl_get_pnames(PyObject *pnames, QList<GLenum> &pname_list,
+        QList<GLint> &sizes, QList<GLenum> &queries)
+{
+    if (!PyList_Check(pnames) && !PyTuple_Check(pnames))
+    {
+        PyErr_Format(PyExc_TypeError,
+                "a list or tuple of parameter names is expected, not '%s'",
+                sipPyTypeName(Py_TYPE(pnames)));
+
+        return false;
+    }
+
+    Py_ssize_t nr_pnames = Sequence_Fast_Size(pnames);
+
+    pname_list.reserve(nr_pnames);
+    sizes.reserve(nr_pnames);
+    queries.reserve(nr_pnames);
+
+    for (Py_ssize_t i = 0; i < nr_pnames; ++i)
+    {
+        PyObject *itm = Sequence_Fast_GetItem(pnames, i);
+
+        if (!itm)
+            return false;
+
+        GLenum pname = sipLong_AsUnsignedInt(itm);
+
+        if (PyErr_Occurred())
+            return false;
+
+        GLenum query = 0;
+
+        pname_list.append(pname);
+        sizes.append(qpyopengl_get(pname, &query));
+        queries.append(query);
+    }
+
+    return true;
+}
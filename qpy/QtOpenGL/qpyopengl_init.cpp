@@ -24,6 +24,10 @@
 #include "qpyopengl_data_cache.h"
 
 
+// Imports from QtCore.
+pyqt6_qtopengl_new_array_t pyqt6_qtopengl_new_array;
+
+
 // Perform any required initialisation.
 void qpyopengl_init()
 {
@@ -31,3 +35,13 @@ void qpyopengl_init()
     if (!qpyopengl_dataCache_init_type())
         Py_FatalError("PyQt6.QtGui: Failed to initialise dataCache type");
 }
+
+
+// Perform any required initialisation after the module has been created.
+void qpyopengl_post_init()
+{
+    // QtCore imports.
+    pyqt6_qtopengl_new_array = (pyqt6_qtopengl_new_array_t)sipImportSymbol(
+            "pyqt6_new_array");
+    Q_ASSERT(pyqt6_qtopengl_new_array);
+}
@@ -28,10 +28,6 @@
 #include "qpyopengl_api.h"
 
 
-// Forward declarations.
-int qpyopengl_add_constants(PyObject *obj);
-
-
 // Create the Python object that wraps the requested OpenGL functions.
 PyObject *qpyopengl_version_functions(
         const QOpenGLVersionProfile &version_profile, QOpenGLContext *context,
@@ -94,17 +90,7 @@ PyObject *qpyopengl_version_functions(
     td = sipType_QOpenGLFunctions_ES2;
 #endif
 
-    // Ownership is with the context.
-    PyObject *funcs_obj = sipConvertFromType(funcs, td, py_context);
-
-    if (funcs_obj)
-    {
-        if (qpyopengl_add_constants(funcs_obj) < 0)
-        {
-            Py_DECREF(funcs_obj);
-            funcs_obj = SIP_NULLPTR;
-        }
-    }
-
-    return funcs_obj;
+    // Ownership is with the context.  Note that the OpenGL constants are
+    // provided by QAbstractOpenGLFunctions.__getattr__().
+    return sipConvertFromType(funcs, td, py_context);
 }
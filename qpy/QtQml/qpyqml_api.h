@@ -56,6 +56,35 @@ extern pyqt6_qtqml_err_print_t pyqt6_qtqml_err_print;
 typedef const QMetaObject *(*pyqt6_qtqml_get_qmetaobject_t)(PyTypeObject *);
 extern pyqt6_qtqml_get_qmetaobject_t pyqt6_qtqml_get_qmetaobject;
 
+// GIL tracing.
+typedef qint64 (*pyqt6_qtqml_gil_trace_begin_t)();
+extern pyqt6_qtqml_gil_trace_begin_t pyqt6_qtqml_gil_trace_begin;
+
+typedef void (*pyqt6_qtqml_gil_trace_end_t)(void *, qint64, qint64);
+extern pyqt6_qtqml_gil_trace_end_t pyqt6_qtqml_gil_trace_end;
+
+typedef qint64 (*pyqt6_qtqml_gil_trace_now_t)();
+extern pyqt6_qtqml_gil_trace_now_t pyqt6_qtqml_gil_trace_now;
+
+typedef void *(*pyqt6_qtqml_gil_trace_site_t)(const char *);
+extern pyqt6_qtqml_gil_trace_site_t pyqt6_qtqml_gil_trace_site;
+
+// Versions of SIP_BLOCK_THREADS and SIP_UNBLOCK_THREADS that trace the
+// acquisition of the GIL at a named site.
+#define QPYQML_BLOCK_THREADS(name) \
+    { \
+        static void *qpyqmlGILSite = pyqt6_qtqml_gil_trace_site(name); \
+        qint64 qpyqmlGILBegin = pyqt6_qtqml_gil_trace_begin(); \
+        SIP_BLOCK_THREADS \
+        qint64 qpyqmlGILAcquired = (qpyqmlGILBegin ? pyqt6_qtqml_gil_trace_now() : 0);
+
+#define QPYQML_UNBLOCK_THREADS \
+        if (qpyqmlGILBegin) \
+            pyqt6_qtqml_gil_trace_end(qpyqmlGILSite, qpyqmlGILBegin, \
+                    qpyqmlGILAcquired); \
+        SIP_UNBLOCK_THREADS \
+    }
+
 // Initialisation.
 void qpyqml_post_init(PyObject *module_dict);
 
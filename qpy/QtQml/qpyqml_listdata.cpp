@@ -20,6 +20,7 @@
 
 #include <sip.h>
 
+#include "qpyqml_api.h"
 #include "qpyqml_listdata.h"
 
 
@@ -44,7 +45,7 @@ ListData::ListData(PyObject *py_type_, PyObject *py_obj_, PyObject *py_list_,
 // Destroy the data.
 ListData::~ListData()
 {
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("ListData::~ListData()")
 
     Py_XDECREF(py_type);
     Py_XDECREF(py_obj);
@@ -54,5 +55,5 @@ ListData::~ListData()
     Py_XDECREF(py_at);
     Py_XDECREF(py_clear);
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
@@ -30,6 +30,10 @@
 
 // Imports from QtCore.
 pyqt6_qtqml_err_print_t pyqt6_qtqml_err_print;
+pyqt6_qtqml_gil_trace_begin_t pyqt6_qtqml_gil_trace_begin;
+pyqt6_qtqml_gil_trace_end_t pyqt6_qtqml_gil_trace_end;
+pyqt6_qtqml_gil_trace_now_t pyqt6_qtqml_gil_trace_now;
+pyqt6_qtqml_gil_trace_site_t pyqt6_qtqml_gil_trace_site;
 
 
 // Perform any required initialisation.
@@ -40,6 +44,22 @@ void qpyqml_post_init(PyObject *module_dict)
             "pyqt6_err_print");
     Q_ASSERT(pyqt6_qtqml_err_print);
 
+    pyqt6_qtqml_gil_trace_begin = (pyqt6_qtqml_gil_trace_begin_t)sipImportSymbol(
+            "pyqt6_gil_trace_begin");
+    Q_ASSERT(pyqt6_qtqml_gil_trace_begin);
+
+    pyqt6_qtqml_gil_trace_end = (pyqt6_qtqml_gil_trace_end_t)sipImportSymbol(
+            "pyqt6_gil_trace_end");
+    Q_ASSERT(pyqt6_qtqml_gil_trace_end);
+
+    pyqt6_qtqml_gil_trace_now = (pyqt6_qtqml_gil_trace_now_t)sipImportSymbol(
+            "pyqt6_gil_trace_now");
+    Q_ASSERT(pyqt6_qtqml_gil_trace_now);
+
+    pyqt6_qtqml_gil_trace_site = (pyqt6_qtqml_gil_trace_site_t)sipImportSymbol(
+            "pyqt6_gil_trace_site");
+    Q_ASSERT(pyqt6_qtqml_gil_trace_site);
+
     // Register the our list type.  Note that Q_DECLARE_METATYPE doesn't seem
     // to work.
     qMetaTypeId<QQmlListProperty<QObject> >();
@@ -160,7 +160,7 @@ static PyObject *QQmlListProperty_call(PyObject *, PyObject *args,
 // Append to the list.
 static void list_append(QQmlListProperty<QObject> *p, QObject *el)
 {
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("list_append()")
 
     ListData *ldata = reinterpret_cast<ListData *>(p->data);
     bool ok = false;
@@ -205,7 +205,7 @@ static void list_append(QQmlListProperty<QObject> *p, QObject *el)
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -214,7 +214,7 @@ static qsizetype list_count(QQmlListProperty<QObject> *p)
 {
     qsizetype res = -1;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("list_count()")
 
     ListData *ldata = reinterpret_cast<ListData *>(p->data);
 
@@ -249,7 +249,7 @@ static qsizetype list_count(QQmlListProperty<QObject> *p)
         res = 0;
     }
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 
     return res;
 }
@@ -260,7 +260,7 @@ static QObject *list_at(QQmlListProperty<QObject> *p, qsizetype idx)
 {
     QObject *qobj = 0;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("list_at()")
 
     ListData *ldata = reinterpret_cast<ListData *>(p->data);
 
@@ -297,7 +297,7 @@ static QObject *list_at(QQmlListProperty<QObject> *p, qsizetype idx)
     if (!qobj)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 
     return qobj;
 }
@@ -306,7 +306,7 @@ static QObject *list_at(QQmlListProperty<QObject> *p, qsizetype idx)
 // Clear the list.
 static void list_clear(QQmlListProperty<QObject> *p)
 {
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("list_clear()")
 
     ListData *ldata = reinterpret_cast<ListData *>(p->data);
     bool ok = false;
@@ -336,7 +336,7 @@ static void list_clear(QQmlListProperty<QObject> *p)
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
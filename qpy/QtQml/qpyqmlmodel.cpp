@@ -46,9 +46,9 @@ QPyQmlModelProxy::~QPyQmlModelProxy()
 {
     proxies.remove(this);
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlModelProxy::~QPyQmlModelProxy()")
     Py_XDECREF(py_proxied);
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 
     if (!proxied.isNull())
         // Deleting it now can cause a crash.
@@ -142,7 +142,7 @@ void QPyQmlModelProxy::createPyObject(QObject *parent)
 {
     static const sipTypeDef *model_td = 0;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlModelProxy::createPyObject()")
 
     if (!model_td)
         model_td = sipFindType("QAbstractItemModel");
@@ -174,7 +174,7 @@ void QPyQmlModelProxy::createPyObject(QObject *parent)
         pyqt6_qtqml_err_print();
     }
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -199,7 +199,7 @@ QObject *QPyQmlModelProxy::createAttachedProperties(PyTypeObject *py_type,
 {
     QObject *qobj = 0;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlModelProxy::createAttachedProperties()")
 
     PyObject *obj = sipCallMethod(NULL, (PyObject *)py_type, "D", parent,
             sipType_QObject, NULL);
@@ -218,7 +218,7 @@ QObject *QPyQmlModelProxy::createAttachedProperties(PyTypeObject *py_type,
         pyqt6_qtqml_err_print();
     }
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 
     return qobj;
 }
@@ -230,7 +230,7 @@ void QPyQmlModelProxy::pyClassBegin()
     if (!py_proxied)
         return;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlModelProxy::pyClassBegin()")
 
     bool ok = false;
 
@@ -258,7 +258,7 @@ void QPyQmlModelProxy::pyClassBegin()
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -268,7 +268,7 @@ void QPyQmlModelProxy::pyComponentComplete()
     if (!py_proxied)
         return;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlModelProxy::pyComponentComplete()")
 
     bool ok = false;
 
@@ -296,7 +296,7 @@ void QPyQmlModelProxy::pyComponentComplete()
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -306,7 +306,7 @@ void QPyQmlModelProxy::pySetTarget(const QQmlProperty &target)
     if (!py_proxied)
         return;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlModelProxy::pySetTarget()")
 
     bool ok = false;
 
@@ -348,7 +348,7 @@ void QPyQmlModelProxy::pySetTarget(const QQmlProperty &target)
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -46,9 +46,9 @@ QPyQmlObjectProxy::~QPyQmlObjectProxy()
 {
     proxies.remove(this);
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlObjectProxy::~QPyQmlObjectProxy()")
     Py_XDECREF(py_proxied);
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 
     if (!proxied.isNull())
         // Deleting it now can cause a crash.
@@ -140,7 +140,7 @@ int QPyQmlObjectProxy::addType(PyTypeObject *type)
 // Create the Python instance.
 void QPyQmlObjectProxy::createPyObject(QObject *parent)
 {
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlObjectProxy::createPyObject()")
 
     py_proxied = sipCallMethod(NULL, (PyObject *)pyqt_types.at(typeNr()), "D",
             parent, sipType_QObject, NULL);
@@ -161,7 +161,7 @@ void QPyQmlObjectProxy::createPyObject(QObject *parent)
         pyqt6_qtqml_err_print();
     }
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -186,7 +186,7 @@ QObject *QPyQmlObjectProxy::createAttachedProperties(PyTypeObject *py_type,
 {
     QObject *qobj = 0;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlObjectProxy::createAttachedProperties()")
 
     PyObject *obj = sipCallMethod(NULL, (PyObject *)py_type, "D", parent,
             sipType_QObject, NULL);
@@ -205,7 +205,7 @@ QObject *QPyQmlObjectProxy::createAttachedProperties(PyTypeObject *py_type,
         pyqt6_qtqml_err_print();
     }
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 
     return qobj;
 }
@@ -217,7 +217,7 @@ void QPyQmlObjectProxy::pyClassBegin()
     if (!py_proxied)
         return;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlObjectProxy::pyClassBegin()")
 
     bool ok = false;
 
@@ -245,7 +245,7 @@ void QPyQmlObjectProxy::pyClassBegin()
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -255,7 +255,7 @@ void QPyQmlObjectProxy::pyComponentComplete()
     if (!py_proxied)
         return;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlObjectProxy::pyComponentComplete()")
 
     bool ok = false;
 
@@ -283,7 +283,7 @@ void QPyQmlObjectProxy::pyComponentComplete()
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -293,7 +293,7 @@ void QPyQmlObjectProxy::pySetTarget(const QQmlProperty &target)
     if (!py_proxied)
         return;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlObjectProxy::pySetTarget()")
 
     bool ok = false;
 
@@ -335,7 +335,7 @@ void QPyQmlObjectProxy::pySetTarget(const QQmlProperty &target)
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -44,7 +44,7 @@ QObject *QPyQmlSingletonObjectProxy::createObject(QQmlEngine *engine,
 
     QObject *qobject;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlSingletonObjectProxy::createObject()")
 
     PyObject *py_obj = sipCallMethod(NULL, factory, "DD", engine,
             sipType_QQmlEngine, NULL, scriptEngine, sipType_QJSEngine, NULL);
@@ -66,7 +66,7 @@ QObject *QPyQmlSingletonObjectProxy::createObject(QQmlEngine *engine,
 
     Py_DECREF(factory);
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 
     return qobject;
 }
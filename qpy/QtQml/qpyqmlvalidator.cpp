@@ -46,9 +46,9 @@ QPyQmlValidatorProxy::~QPyQmlValidatorProxy()
 {
     proxies.remove(this);
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlValidatorProxy::~QPyQmlValidatorProxy()")
     Py_XDECREF(py_proxied);
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 
     if (!proxied.isNull())
         delete proxied.data();
@@ -143,7 +143,7 @@ void QPyQmlValidatorProxy::createPyObject(QObject *parent)
 {
     static const sipTypeDef *validator_td = 0;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlValidatorProxy::createPyObject()")
 
     if (!validator_td)
         validator_td = sipFindType("QValidator");
@@ -165,7 +165,7 @@ void QPyQmlValidatorProxy::createPyObject(QObject *parent)
         pyqt6_qtqml_err_print();
     }
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -190,7 +190,7 @@ QObject *QPyQmlValidatorProxy::createAttachedProperties(PyTypeObject *py_type,
 {
     QObject *qobj = 0;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlValidatorProxy::createAttachedProperties()")
 
     PyObject *obj = sipCallMethod(NULL, (PyObject *)py_type, "D", parent,
             sipType_QObject, NULL);
@@ -209,7 +209,7 @@ QObject *QPyQmlValidatorProxy::createAttachedProperties(PyTypeObject *py_type,
         pyqt6_qtqml_err_print();
     }
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 
     return qobj;
 }
@@ -221,7 +221,7 @@ void QPyQmlValidatorProxy::pyClassBegin()
     if (!py_proxied)
         return;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlValidatorProxy::pyClassBegin()")
 
     bool ok = false;
 
@@ -249,7 +249,7 @@ void QPyQmlValidatorProxy::pyClassBegin()
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -259,7 +259,7 @@ void QPyQmlValidatorProxy::pyComponentComplete()
     if (!py_proxied)
         return;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlValidatorProxy::pyComponentComplete()")
 
     bool ok = false;
 
@@ -287,7 +287,7 @@ void QPyQmlValidatorProxy::pyComponentComplete()
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
@@ -297,7 +297,7 @@ void QPyQmlValidatorProxy::pySetTarget(const QQmlProperty &target)
     if (!py_proxied)
         return;
 
-    SIP_BLOCK_THREADS
+    QPYQML_BLOCK_THREADS("QPyQmlValidatorProxy::pySetTarget()")
 
     bool ok = false;
 
@@ -339,7 +339,7 @@ void QPyQmlValidatorProxy::pySetTarget(const QQmlProperty &target)
     if (!ok)
         pyqt6_qtqml_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQML_UNBLOCK_THREADS
 }
 
 
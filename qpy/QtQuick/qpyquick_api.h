@@ -22,10 +22,42 @@
 #define _QPYQUICK_API_H
 
 
+#include <QtGlobal>
+
+
 // Python exception handling.
 typedef void (*pyqt6_qtquick_err_print_t)();
 extern pyqt6_qtquick_err_print_t pyqt6_qtquick_err_print;
 
+// GIL tracing.
+typedef qint64 (*pyqt6_qtquick_gil_trace_begin_t)();
+extern pyqt6_qtquick_gil_trace_begin_t pyqt6_qtquick_gil_trace_begin;
+
+typedef void (*pyqt6_qtquick_gil_trace_end_t)(void *, qint64, qint64);
+extern pyqt6_qtquick_gil_trace_end_t pyqt6_qtquick_gil_trace_end;
+
+typedef qint64 (*pyqt6_qtquick_gil_trace_now_t)();
+extern pyqt6_qtquick_gil_trace_now_t pyqt6_qtquick_gil_trace_now;
+
+typedef void *(*pyqt6_qtquick_gil_trace_site_t)(const char *);
+extern pyqt6_qtquick_gil_trace_site_t pyqt6_qtquick_gil_trace_site;
+
+// Versions of SIP_BLOCK_THREADS and SIP_UNBLOCK_THREADS that trace the
+// acquisition of the GIL at a named site.
+#define QPYQUICK_BLOCK_THREADS(name) \
+    { \
+        static void *qpyquickGILSite = pyqt6_qtquick_gil_trace_site(name); \
+        qint64 qpyquickGILBegin = pyqt6_qtquick_gil_trace_begin(); \
+        SIP_BLOCK_THREADS \
+        qint64 qpyquickGILAcquired = (qpyquickGILBegin ? pyqt6_qtquick_gil_trace_now() : 0);
+
+#define QPYQUICK_UNBLOCK_THREADS \
+        if (qpyquickGILBegin) \
+            pyqt6_qtquick_gil_trace_end(qpyquickGILSite, qpyquickGILBegin, \
+                    qpyquickGILAcquired); \
+        SIP_UNBLOCK_THREADS \
+    }
+
 // Initialisation.
 void qpyquick_post_init();
 
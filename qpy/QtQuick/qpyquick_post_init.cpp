@@ -27,6 +27,10 @@
 
 // Imports from QtCore.
 pyqt6_qtquick_err_print_t pyqt6_qtquick_err_print;
+pyqt6_qtquick_gil_trace_begin_t pyqt6_qtquick_gil_trace_begin;
+pyqt6_qtquick_gil_trace_end_t pyqt6_qtquick_gil_trace_end;
+pyqt6_qtquick_gil_trace_now_t pyqt6_qtquick_gil_trace_now;
+pyqt6_qtquick_gil_trace_site_t pyqt6_qtquick_gil_trace_site;
 
 
 // Perform any required initialisation.
@@ -53,6 +57,22 @@ void qpyquick_post_init()
             "pyqt6_err_print");
     Q_ASSERT(pyqt6_qtquick_err_print);
 
+    pyqt6_qtquick_gil_trace_begin = (pyqt6_qtquick_gil_trace_begin_t)sipImportSymbol(
+            "pyqt6_gil_trace_begin");
+    Q_ASSERT(pyqt6_qtquick_gil_trace_begin);
+
+    pyqt6_qtquick_gil_trace_end = (pyqt6_qtquick_gil_trace_end_t)sipImportSymbol(
+            "pyqt6_gil_trace_end");
+    Q_ASSERT(pyqt6_qtquick_gil_trace_end);
+
+    pyqt6_qtquick_gil_trace_now = (pyqt6_qtquick_gil_trace_now_t)sipImportSymbol(
+            "pyqt6_gil_trace_now");
+    Q_ASSERT(pyqt6_qtquick_gil_trace_now);
+
+    pyqt6_qtquick_gil_trace_site = (pyqt6_qtquick_gil_trace_site_t)sipImportSymbol(
+            "pyqt6_gil_trace_site");
+    Q_ASSERT(pyqt6_qtquick_gil_trace_site);
+
     // Export the qml_register_type() helper.
     sipExportSymbol("qtquick_register_item", (void *)qpyquick_register_type);
 }
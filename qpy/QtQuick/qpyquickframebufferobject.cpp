@@ -126,7 +126,7 @@ QQmlPrivate::RegisterType *QPyQuickFramebufferObject::addType(
 // Create the Python instance.
 void QPyQuickFramebufferObject::createPyObject(QQuickItem *parent)
 {
-    SIP_BLOCK_THREADS
+    QPYQUICK_BLOCK_THREADS("QPyQuickFramebufferObject::createPyObject()")
 
     // Assume C++ owns everything.
     PyObject *obj = sipConvertFromNewPyType(this, pyqt_types.at(typeNr()),
@@ -135,7 +135,7 @@ void QPyQuickFramebufferObject::createPyObject(QQuickItem *parent)
     if (!obj)
         pyqt6_qtquick_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQUICK_UNBLOCK_THREADS
 }
 
 
@@ -167,7 +167,7 @@ QQmlPrivate::RegisterType *QPyQuickItem::addType(PyTypeObject *type,
 // Create the Python instance.
 void QPyQuickItem::createPyObject(QQuickItem *parent)
 {
-    SIP_BLOCK_THREADS
+    QPYQUICK_BLOCK_THREADS("QPyQuickItem::createPyObject()")
 
     // Assume C++ owns everything.
     PyObject *obj = sipConvertFromNewPyType(this, pyqt_types.at(typeNr()),
@@ -176,7 +176,7 @@ void QPyQuickItem::createPyObject(QQuickItem *parent)
     if (!obj)
         pyqt6_qtquick_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQUICK_UNBLOCK_THREADS
 }
 
 
@@ -126,7 +126,7 @@ QQmlPrivate::RegisterType *QPyQuickPaintedItem::addType(PyTypeObject *type,
 // Create the Python instance.
 void QPyQuickPaintedItem::createPyObject(QQuickItem *parent)
 {
-    SIP_BLOCK_THREADS
+    QPYQUICK_BLOCK_THREADS("QPyQuickPaintedItem::createPyObject()")
 
     // Assume C++ owns everything.
     PyObject *obj = sipConvertFromNewPyType(this, pyqt_types.at(typeNr()),
@@ -135,7 +135,7 @@ void QPyQuickPaintedItem::createPyObject(QQuickItem *parent)
     if (!obj)
         pyqt6_qtquick_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQUICK_UNBLOCK_THREADS
 }
 
 
@@ -115,7 +115,7 @@ QQmlPrivate::RegisterType *QPyQuickView::addType(PyTypeObject *type,
 // Create the Python instance.
 void QPyQuickView::createPyObject(QWindow *parent)
 {
-    SIP_BLOCK_THREADS
+    QPYQUICK_BLOCK_THREADS("QPyQuickView::createPyObject()")
 
     // Assume C++ owns everything.
     PyObject *obj = sipConvertFromNewPyType(this, pyqt_types.at(typeNr()),
@@ -124,7 +124,7 @@ void QPyQuickView::createPyObject(QWindow *parent)
     if (!obj)
         pyqt6_qtquick_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQUICK_UNBLOCK_THREADS
 }
 
 
@@ -115,7 +115,7 @@ QQmlPrivate::RegisterType *QPyQuickWindow::addType(PyTypeObject *type,
 // Create the Python instance.
 void QPyQuickWindow::createPyObject(QWindow *parent)
 {
-    SIP_BLOCK_THREADS
+    QPYQUICK_BLOCK_THREADS("QPyQuickWindow::createPyObject()")
 
     // Assume C++ owns everything.
     PyObject *obj = sipConvertFromNewPyType(this, pyqt_types.at(typeNr()),
@@ -124,7 +124,7 @@ void QPyQuickWindow::createPyObject(QWindow *parent)
     if (!obj)
         pyqt6_qtquick_err_print();
 
-    SIP_UNBLOCK_THREADS
+    QPYQUICK_UNBLOCK_THREADS
 }
 
 